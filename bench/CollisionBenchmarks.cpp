@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+
+#include "GameConfig.h"
+#include "managers/CollisionManager.h"
+
+namespace {
+
+class BenchCollidable : public ICollidable {
+ public:
+  explicit BenchCollidable(const SDL_FRect &box) : box(box) {}
+
+  SDL_FRect getCollisionBox() const override { return box; }
+  SDL_FRect getAttackBox() const override { return SDL_FRect{0, 0, 0, 0}; }
+  CollisionLayer getCollisionLayer() const override { return CollisionLayer::PLAYER; }
+  bool isCollisionEnabled() const override { return true; }
+  void onCollision(const CollisionInfo &info) override { collisionCount++; }
+  glm::vec2 getPosition() const override { return glm::vec2(box.x, box.y); }
+  glm::vec2 getVelocity() const override { return glm::vec2(0.0f); }
+
+ private:
+  SDL_FRect box;
+  size_t collisionCount = 0;
+};
+
+void BM_CheckAABBCollision(benchmark::State &state) {
+  CollisionManager &collisionManager = CollisionManager::getInstance();
+
+  // Alternates between overlapping and separated pairs so the branch is not always taken
+  SDL_FRect boxes[] = {{0, 0, 32, 48}, {20, 10, 32, 48}, {100, 0, 32, 48}, {10, 40, 32, 48}};
+  size_t index = 0;
+
+  for (auto _ : state) {
+    CollisionInfo info;
+    bool hit = collisionManager.checkAABBCollision(boxes[0], boxes[1 + index], &info);
+    benchmark::DoNotOptimize(hit);
+    benchmark::DoNotOptimize(info);
+    index = (index + 1) % 3;
+  }
+}
+BENCHMARK(BM_CheckAABBCollision);
+
+void BM_CheckAllCollisions(benchmark::State &state) {
+  CollisionManager &collisionManager = CollisionManager::getInstance();
+  collisionManager.clearAll();
+
+  // Fighter sized boxes spread over the stage, the seed keeps the overlap count stable between runs
+  std::mt19937 random(1234);
+  std::uniform_real_distribution<float> x(0.0f, GameConfig::STAGE_WIDTH - 32.0f);
+  std::uniform_real_distribution<float> y(0.0f, GameConfig::STAGE_HEIGHT - 48.0f);
+
+  const int64_t count = state.range(0);
+  for (int64_t i = 0; i < count; ++i) {
+    collisionManager.registerCollidable(std::make_shared<BenchCollidable>(SDL_FRect{x(random), y(random), 32, 48}));
+  }
+
+  for (auto _ : state) {
+    collisionManager.update(0.0f);
+  }
+
+  state.counters["collisions"] = static_cast<double>(collisionManager.getLastFrameCollisions().size());
+  state.SetComplexityN(count);
+  collisionManager.clearAll();
+}
+BENCHMARK(BM_CheckAllCollisions)->RangeMultiplier(4)->Range(16, 4096)->Complexity(benchmark::oNSquared);
+
+}  // namespace
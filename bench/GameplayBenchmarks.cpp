@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "Animation.h"
+#include "Player.h"
+#include "managers/InputManager.h"
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+void BM_PlayerUpdate(benchmark::State &state) {
+  Player player(true);
+
+  for (auto _ : state) {
+    player.update(TICK);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_PlayerUpdate);
+
+void BM_AnimationStep(benchmark::State &state) {
+  AnimationClip clip(8, 12.0f / 60.0f, LoopMode::LOOP);
+  AnimationPlayhead playhead(&clip);
+
+  for (auto _ : state) {
+    playhead.step(TICK);
+    benchmark::DoNotOptimize(playhead.getTime());
+  }
+}
+BENCHMARK(BM_AnimationStep);
+
+void BM_AnimationCurrentFrame(benchmark::State &state) {
+  // Uneven frame lengths, the case the lookup table exists for
+  AnimationClip clip(8, std::vector<float>{0.05f, 0.2f, 0.1f, 0.3f, 0.05f, 0.1f, 0.15f, 0.2f}, LoopMode::LOOP);
+  AnimationPlayhead playhead(&clip);
+
+  for (auto _ : state) {
+    playhead.step(0.0137f);
+    benchmark::DoNotOptimize(playhead.currentFrame());
+  }
+}
+BENCHMARK(BM_AnimationCurrentFrame);
+
+void BM_InputProcessEvent(benchmark::State &state) {
+  // Presses and releases of bound keys mixed with a key that is not mapped
+  const SDL_Scancode scancodes[] = {SDL_SCANCODE_A, SDL_SCANCODE_RIGHT, SDL_SCANCODE_SPACE, SDL_SCANCODE_F2};
+  std::vector<SDL_Event> events;
+  for (SDL_Scancode scancode : scancodes) {
+    for (bool down : {true, false}) {
+      SDL_Event event{};
+      event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+      event.key.scancode = scancode;
+      event.key.down = down;
+      events.push_back(event);
+    }
+  }
+
+  // Enough events per iteration that pausing the timer to retire them costs little
+  const int BATCHES = 128;
+
+  InputManager inputManager;
+  uint64_t tick = 0;
+  const Uint64 presentNs = SDL_GetTicksNS();
+
+  for (auto _ : state) {
+    for (int batch = 0; batch < BATCHES; ++batch) {
+      for (const SDL_Event &event : events) {
+        inputManager.processEvent(event);
+      }
+    }
+
+    // Recorded transitions are retired outside the measurement, see BM_InputFrame
+    state.PauseTiming();
+    inputManager.markApplied(++tick);
+    inputManager.markPresented(presentNs);
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * BATCHES * static_cast<int64_t>(events.size()));
+}
+BENCHMARK(BM_InputProcessEvent);
+
+// The input work of a whole frame, events plus retiring their transitions into the latency samples
+void BM_InputFrame(benchmark::State &state) {
+  const SDL_Scancode scancodes[] = {SDL_SCANCODE_A, SDL_SCANCODE_RIGHT};
+  std::vector<SDL_Event> events;
+  for (SDL_Scancode scancode : scancodes) {
+    for (bool down : {true, false}) {
+      SDL_Event event{};
+      event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+      event.key.scancode = scancode;
+      event.key.down = down;
+      events.push_back(event);
+    }
+  }
+
+  InputManager inputManager;
+  uint64_t tick = 0;
+  const Uint64 presentNs = SDL_GetTicksNS();
+
+  for (auto _ : state) {
+    for (const SDL_Event &event : events) {
+      inputManager.processEvent(event);
+    }
+    inputManager.markApplied(++tick);
+    inputManager.markPresented(presentNs);
+  }
+}
+BENCHMARK(BM_InputFrame);
+
+}  // namespace
@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+
+#include "AssetManifest.h"
+#include "managers/ResourceManager.h"
+
+namespace {
+
+void BM_GetTextureCacheHit(benchmark::State &state) {
+  ResourceManager &resources = ResourceManager::getInstance();
+
+  // Preloaded by initialize(), main() waits until it is uploaded
+  TextureHandle resident = resources.getTexture(Assets::textures::player1::idle);
+  if (!resident.isReady()) {
+    state.SkipWithError("idle texture did not load");
+    return;
+  }
+
+  for (auto _ : state) {
+    TextureHandle handle = resources.getTexture(Assets::textures::player1::idle);
+    benchmark::DoNotOptimize(handle);
+  }
+}
+BENCHMARK(BM_GetTextureCacheHit);
+
+}  // namespace
@@ -0,0 +1,45 @@
+#include <SDL3/SDL.h>
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+
+#include "managers/ResourceManager.h"
+
+// Benchmarks run against the real ResourceManager with a software renderer, so textures
+// and the player state machines are available without opening a window
+int main(int argc, char *argv[]) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+  SDL_Renderer *renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+  if (!renderer) {
+    std::cerr << "Failed to create software renderer: " << SDL_GetError() << '\n';
+    return 1;
+  }
+
+  ResourceManager &resources = ResourceManager::getInstance();
+  if (!resources.initialize()) {
+    std::cerr << "Failed to initialize ResourceManager" << '\n';
+    return 1;
+  }
+  resources.attachRenderer(renderer);
+
+  // Wait for the preloaded textures so lookups measure cache hits
+  const Uint64 timeout = SDL_GetTicks() + 10000;
+  while (resources.isLoading() && SDL_GetTicks() < timeout) {
+    resources.processUploads(16.0);
+    SDL_Delay(1);
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  resources.cleanup();
+  SDL_DestroyRenderer(renderer);
+  SDL_DestroySurface(surface);
+  SDL_Quit();
+
+  return 0;
+}
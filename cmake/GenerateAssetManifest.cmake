@@ -0,0 +1,82 @@
+# Writes AssetManifest.h with one constexpr AssetId per file under RESOURCE_DIR.
+#
+#   cmake -DRESOURCE_DIR=<dir> -DOUTPUT=<header> -P GenerateAssetManifest.cmake
+#
+# resources/textures/player1/idle.png becomes Assets::textures::player1::idle
+
+if(NOT RESOURCE_DIR OR NOT OUTPUT)
+    message(FATAL_ERROR "RESOURCE_DIR and OUTPUT are required")
+endif()
+
+get_filename_component(RESOURCE_ROOT_NAME ${RESOURCE_DIR} NAME)
+file(GLOB_RECURSE ASSET_FILES RELATIVE ${RESOURCE_DIR} "${RESOURCE_DIR}/*")
+list(SORT ASSET_FILES)
+
+set(CONTENT "// Generated by cmake/GenerateAssetManifest.cmake from ${RESOURCE_ROOT_NAME}/, do not edit\n")
+string(APPEND CONTENT "#pragma once\n\n#include <string_view>\n\n#include \"utils/AssetId.h\"\n\nnamespace Assets {\n")
+
+set(CURRENT_NAMESPACE "")
+set(ALL_IDS "")
+
+foreach(ASSET_FILE ${ASSET_FILES})
+    get_filename_component(ASSET_DIR ${ASSET_FILE} DIRECTORY)
+    get_filename_component(ASSET_NAME ${ASSET_FILE} NAME_WE)
+
+    string(MAKE_C_IDENTIFIER "${ASSET_NAME}" ASSET_IDENTIFIER)
+
+    set(ASSET_NAMESPACE "")
+    if(ASSET_DIR)
+        string(REPLACE "/" ";" DIR_PARTS ${ASSET_DIR})
+        set(NAMESPACE_PARTS "")
+        foreach(DIR_PART ${DIR_PARTS})
+            string(MAKE_C_IDENTIFIER "${DIR_PART}" DIR_IDENTIFIER)
+            list(APPEND NAMESPACE_PARTS ${DIR_IDENTIFIER})
+        endforeach()
+        list(JOIN NAMESPACE_PARTS "::" ASSET_NAMESPACE)
+    endif()
+
+    if(NOT ASSET_NAMESPACE STREQUAL CURRENT_NAMESPACE)
+        if(CURRENT_NAMESPACE)
+            string(APPEND CONTENT "}  // namespace ${CURRENT_NAMESPACE}\n")
+        endif()
+        if(ASSET_NAMESPACE)
+            string(APPEND CONTENT "\nnamespace ${ASSET_NAMESPACE} {\n")
+        endif()
+        set(CURRENT_NAMESPACE ${ASSET_NAMESPACE})
+    endif()
+
+    string(APPEND CONTENT "inline constexpr AssetId ${ASSET_IDENTIFIER}{\"${RESOURCE_ROOT_NAME}/${ASSET_FILE}\"};\n")
+
+    if(ASSET_NAMESPACE)
+        list(APPEND ALL_IDS "${ASSET_NAMESPACE}::${ASSET_IDENTIFIER}")
+    else()
+        list(APPEND ALL_IDS "${ASSET_IDENTIFIER}")
+    endif()
+endforeach()
+
+if(CURRENT_NAMESPACE)
+    string(APPEND CONTENT "}  // namespace ${CURRENT_NAMESPACE}\n")
+endif()
+
+string(APPEND CONTENT "\ninline constexpr AssetId ALL[] = {\n")
+foreach(ASSET_ID ${ALL_IDS})
+    string(APPEND CONTENT "    ${ASSET_ID},\n")
+endforeach()
+string(APPEND CONTENT "};\n\n")
+
+string(APPEND CONTENT "static_assert(hasUniqueHashes(ALL), \"Asset path hash collision, rename one of the assets\");\n\n")
+string(APPEND CONTENT "// Resolves a path at compile time, an unknown path fails the build\n")
+string(APPEND CONTENT "consteval AssetId fromPath(std::string_view path) {\n")
+string(APPEND CONTENT "  for (const AssetId &id : ALL) {\n    if (id.getPath() == path)\n      return id;\n  }\n")
+string(APPEND CONTENT "  throw \"Unknown asset path\";\n}\n\n")
+string(APPEND CONTENT "}  // namespace Assets\n")
+
+# Only touch the header when the manifest changed, so unrelated asset edits don't rebuild
+if(EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} EXISTING_CONTENT)
+    if(EXISTING_CONTENT STREQUAL CONTENT)
+        return()
+    endif()
+endif()
+
+file(WRITE ${OUTPUT} "${CONTENT}")
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+struct AllocationCounters {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+// Counts heap allocations through replacements of the global operator new. The hooks are only built
+// with BLOODHORIZON_PROFILE, in Release every getter returns zero.
+class AllocationTracker {
+ public:
+  static constexpr bool ENABLED =
+#ifdef BLOODHORIZON_PROFILE
+      true;
+#else
+      false;
+#endif
+
+  // Allocations made by the calling thread since it started
+  static AllocationCounters getThreadCounters();
+
+  // Main thread, once per frame. Keeps the allocations made by the main thread during the frame.
+  static void endFrame();
+  static const AllocationCounters &getLastFrame() { return lastFrame; }
+
+  // Abort instead of only reporting when a no-alloc region allocates
+  static void setAbortOnViolation(bool enabled) { abortOnViolation = enabled; }
+  static uint64_t getViolationCount() { return violations.load(std::memory_order_relaxed); }
+
+  // Called by the operator new replacements
+  static void onAllocate(size_t size);
+
+ private:
+  friend class NoAllocScope;
+
+  static inline AllocationCounters lastFrame;
+  static inline AllocationCounters frameStart;
+  static inline std::atomic<uint64_t> violations{0};
+  static inline bool abortOnViolation = false;
+};
+
+// Any allocation on this thread while the scope is alive is a violation, scopes may nest
+class NoAllocScope {
+ public:
+  explicit NoAllocScope(const char *region);
+  ~NoAllocScope();
+
+  NoAllocScope(const NoAllocScope &) = delete;
+  NoAllocScope &operator=(const NoAllocScope &) = delete;
+
+ private:
+  const char *previousRegion;
+};
+
+#ifdef BLOODHORIZON_PROFILE
+#define NO_ALLOC_CONCAT_INNER(a, b) a##b
+#define NO_ALLOC_CONCAT(a, b) NO_ALLOC_CONCAT_INNER(a, b)
+#define NO_ALLOC_SCOPE(region) NoAllocScope NO_ALLOC_CONCAT(noAllocScope, __LINE__)(region)
+#else
+#define NO_ALLOC_SCOPE(region) ((void)0)
+#endif
@@ -1,51 +1,129 @@
 #pragma once
 
-class Animation {
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+enum class LoopMode {
+  LOOP,
+  ONCE
+};
+
+// Immutable animation data, created once and shared by every entity that plays it
+class AnimationClip {
  public:
-  Animation() : frameCount(0), framesPerSpriteFrame(10), frameCounter(0) {}
+  AnimationClip() = default;
 
-  Animation(int frameCount, int framesPerSpriteFrame)
-      : frameCount(frameCount), framesPerSpriteFrame(framesPerSpriteFrame), frameCounter(0) {}
+  // Horizontal strip of equally sized frames, UV rects are normalized to the texture size
+  AnimationClip(int frameCount, const std::vector<float> &frameDurations, LoopMode loopMode)
+      : loopMode(loopMode) {
+    if (frameCount <= 0 || frameDurations.empty())
+      return;
+
+    float frameWidth = 1.0f / frameCount;
+    float time = 0.0f;
+    for (int i = 0; i < frameCount; ++i) {
+      float duration = i < static_cast<int>(frameDurations.size()) ? frameDurations[i] : frameDurations.back();
+      time += std::max(duration, 0.001f);
+
+      uvRects.push_back(SDL_FRect{i * frameWidth, 0.0f, frameWidth, 1.0f});
+      frameEnds.push_back(time);
+    }
+    length = time;
 
-  Animation(int frameCount, float length) : frameCount(frameCount), frameCounter(0) {
-    framesPerSpriteFrame = static_cast<int>((length * 60.0f) / frameCount);
-    if (framesPerSpriteFrame < 1)
-      framesPerSpriteFrame = 1;
+    buildLookup();
   }
 
-  float getLength() const { return (frameCount * framesPerSpriteFrame) / 60.0f; }
-  float getTime() const { return frameCounter / 60.0f; }
-  int getFrameCount() const { return frameCount; }
+  AnimationClip(int frameCount, float frameDuration, LoopMode loopMode)
+      : AnimationClip(frameCount, std::vector<float>{frameDuration}, loopMode) {}
 
-  int currentFrame() const {
-    if (frameCount <= 0)
+  int getFrameCount() const { return static_cast<int>(uvRects.size()); }
+  float getLength() const { return length; }
+  LoopMode getLoopMode() const { return loopMode; }
+
+  const SDL_FRect &getFrameUV(int frame) const { return uvRects[frame]; }
+
+  // O(1): the lookup bucket is no longer than the shortest frame, so it spans at most two frames
+  int frameAt(float time) const {
+    if (lookup.empty())
       return 0;
 
-    int spriteFrame = frameCounter / framesPerSpriteFrame;
+    int bucket = std::clamp(static_cast<int>(time / bucketLength), 0, static_cast<int>(lookup.size()) - 1);
+    int frame = lookup[bucket];
+    if (time >= frameEnds[frame] && frame + 1 < getFrameCount()) {
+      frame++;
+    }
+    return frame;
+  }
+
+ private:
+  void buildLookup() {
+    float shortestFrame = frameEnds[0];
+    for (size_t i = 1; i < frameEnds.size(); ++i) {
+      shortestFrame = std::min(shortestFrame, frameEnds[i] - frameEnds[i - 1]);
+    }
+
+    bucketLength = shortestFrame;
+    int bucketCount = static_cast<int>(std::ceil(length / bucketLength));
+
+    lookup.resize(bucketCount);
+    int frame = 0;
+    for (int bucket = 0; bucket < bucketCount; ++bucket) {
+      float bucketStart = bucket * bucketLength;
+      while (frame + 1 < getFrameCount() && bucketStart >= frameEnds[frame]) {
+        frame++;
+      }
+      lookup[bucket] = static_cast<uint16_t>(frame);
+    }
+  }
+
+  std::vector<SDL_FRect> uvRects;
+  std::vector<float> frameEnds;
+  std::vector<uint16_t> lookup;
+  float bucketLength = 1.0f;
+  float length = 0.0f;
+  LoopMode loopMode = LoopMode::LOOP;
+};
 
-    return spriteFrame % frameCount;
+// Per-entity playback state, only a clip pointer and the elapsed time
+class AnimationPlayhead {
+ public:
+  AnimationPlayhead() = default;
+  explicit AnimationPlayhead(const AnimationClip *clip) : clip(clip) {}
+
+  void play(const AnimationClip *newClip) {
+    clip = newClip;
+    time = 0.0f;
   }
 
   void step(float deltaTime) {
-    frameCounter++;
+    if (!clip || clip->getLength() <= 0.0f)
+      return;
+
+    time += deltaTime;
 
-    int totalFrames = frameCount * framesPerSpriteFrame;
-    if (frameCounter >= totalFrames) {
-      frameCounter = 0;
+    if (clip->getLoopMode() == LoopMode::LOOP) {
+      time = std::fmod(time, clip->getLength());
+    } else {
+      time = std::min(time, clip->getLength());
     }
   }
 
-  void reset() {
-    frameCounter = 0;
-  }
+  void reset() { time = 0.0f; }
+
+  int currentFrame() const { return clip ? clip->frameAt(time) : 0; }
 
   bool isDone() const {
-    int totalFrames = frameCount * framesPerSpriteFrame;
-    return frameCounter >= totalFrames;
+    return clip && clip->getLoopMode() == LoopMode::ONCE && time >= clip->getLength();
   }
 
+  float getTime() const { return time; }
+  const AnimationClip *getClip() const { return clip; }
+
  private:
-  int frameCount;
-  int framesPerSpriteFrame;
-  int frameCounter;
-};
\ No newline at end of file
+  const AnimationClip *clip = nullptr;
+  float time = 0.0f;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Animation.h"
+#include "utils/AssetId.h"
+
+// Inputs to the state machine, combined into a bitmask each tick
+enum class AnimationCondition : uint8_t {
+  MOVING = 1 << 0,     // movement input held
+  STOPPED = 1 << 1,    // horizontal speed below the run threshold
+  CLIP_DONE = 1 << 2,  // current non-looping clip reached its end
+  GROUNDED = 1 << 3,
+  HIT = 1 << 4,        // triggers, only set for the tick they fire on
+  JUMP = 1 << 5,
+  PUNCH = 1 << 6
+};
+
+constexpr uint8_t conditionMask(AnimationCondition condition) {
+  return static_cast<uint8_t>(condition);
+}
+
+constexpr uint8_t conditionMask(AnimationCondition a, AnimationCondition b) {
+  return static_cast<uint8_t>(conditionMask(a) | conditionMask(b));
+}
+
+class AnimationStateMachine {
+ public:
+  using StateId = uint8_t;
+
+  struct State {
+    std::string name;
+    const AnimationClip *clip;
+    AssetId texture;
+  };
+
+  StateId addState(const std::string &name, const AnimationClip *clip, AssetId texture);
+
+  // Transitions are tried in the order they were added, the first match wins
+  void addTransition(StateId from, StateId to, uint8_t required, uint8_t forbidden = 0);
+  void addTransitionFromAny(StateId to, uint8_t required, uint8_t forbidden = 0);
+
+  // Flattens the transition list into a [state][condition mask] -> state table
+  void compile();
+
+  StateId next(StateId current, uint8_t conditions) const {
+    return transitionTable[current * CONDITION_COMBINATIONS + conditions];
+  }
+
+  const State &getState(StateId state) const { return states[state]; }
+  size_t getStateCount() const { return states.size(); }
+
+ private:
+  struct Transition {
+    StateId from;
+    StateId to;
+    uint8_t required;
+    uint8_t forbidden;
+    bool fromAny;
+  };
+
+  static constexpr size_t CONDITION_COMBINATIONS = 256;
+
+  std::vector<State> states;
+  std::vector<Transition> transitions;
+  std::vector<StateId> transitionTable;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <glm/glm.hpp>
+
+class Camera {
+ public:
+  Camera(const SDL_FRect &stageBounds, float viewportWidth, float viewportHeight);
+
+  // Frames both fighters, zooming out as they separate. Smoothed unless snap is set.
+  void follow(const glm::vec2 &targetA, const glm::vec2 &targetB, float deltaTime, bool snap = false);
+
+  void setZoomLimits(float minZoom, float maxZoom);
+  void setStageBounds(const SDL_FRect &bounds) { stageBounds = bounds; }
+
+  // Visible area in world coordinates
+  SDL_FRect getViewRect() const;
+  float getZoom() const { return zoom; }
+
+  glm::vec2 worldToScreen(const glm::vec2 &worldPoint) const;
+  SDL_FRect worldToScreen(const SDL_FRect &worldRect) const;
+  glm::vec2 screenToWorld(const glm::vec2 &screenPoint) const;
+
+  bool isVisible(const SDL_FRect &worldRect) const;
+
+ private:
+  void clampToStage();
+
+  SDL_FRect stageBounds;
+  float viewportWidth, viewportHeight;
+
+  glm::vec2 center;
+  float zoom = 1.0f;
+  float minZoom = 0.75f;
+  float maxZoom = 1.25f;
+
+  // Space kept between the fighters and the screen edges
+  static constexpr float FRAMING_MARGIN = 220.0f;
+  static constexpr float FOLLOW_RATE = 6.0f;
+  static constexpr float ZOOM_RATE = 3.0f;
+};
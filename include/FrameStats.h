@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <string>
+
+#include "utils/HdrHistogram.h"
+
+// Session-long frame, update and render time distributions, written out as p50 to max so
+// builds and machines can be compared. Always collected, independent of the profiler zones.
+class FrameStats {
+ public:
+  // Frames longer than this many target intervals count as a missed vsync
+  static constexpr double MISSED_VSYNC_FACTOR = 1.5;
+
+  // The lower of the display refresh rate and the frame cap
+  void setTargetFrameRate(float targetRateHz);
+
+  void recordFrame(double frameMs, double updateMs, double renderMs);
+
+  // CSV when the path ends in .csv, JSON otherwise
+  bool writeReport(const std::string &path) const;
+  void printSummary() const;
+
+  size_t getMissedVsyncCount() const { return missedVsyncFrames; }
+
+ private:
+  struct Metric {
+    const char *name;
+    const HdrHistogram &histogram;
+  };
+
+  static double toMs(uint64_t microseconds) { return microseconds / 1000.0; }
+
+  HdrHistogram frameTimes;
+  HdrHistogram updateTimes;
+  HdrHistogram renderTimes;
+
+  float targetRateHz = 60.0f;
+  size_t missedVsyncFrames = 0;
+};
@@ -4,20 +4,29 @@
 
 #include <memory>
 
+#include "FrameStats.h"
+#include "LaunchOptions.h"
+#include "managers/LiveStatePublisher.h"
 #include "managers/ResolutionManager.h"
 #include "managers/ResourceManager.h"
+#include "managers/TraceWriter.h"
 #include "utils/SDLDeleter.h"
+#include "utils/StartupTrace.h"
 #include "views/GameLoop.h"
+#include "views/LoadingScreen.h"
 #include "views/MainMenu.h"
+#include "views/StressTest.h"
 
 enum class GameState {
+  LOADING,
   MAINMENU,
-  GAMELOOP
+  GAMELOOP,
+  STRESS
 };
 
 class Game {
  public:
-  Game();
+  Game(const LaunchOptions &options);
   ~Game();
 
   void cleanup();
@@ -26,15 +35,27 @@ class Game {
   void changeResolution(const Resolution &newResolution);
 
  private:
+  LaunchOptions options;
+  StartupTrace startupTrace;
+  TraceWriter traceWriter;
+  FrameStats frameStats;
+  LiveStatePublisher liveState;
+
   unique_window window;
   unique_renderer renderer;
 
-  GameState currentGameState = GameState::MAINMENU;
+  // The whole scene is drawn at logical resolution into this, then upscaled once on present
+  unique_texture sceneTarget;
+
+  GameState currentGameState = GameState::LOADING;
 
   InputManager inputManager;
+  uint64_t simulationTick = 0;
 
+  std::unique_ptr<LoadingScreen> loadingScreenView = nullptr;
   std::unique_ptr<MainMenu> mainMenuView = nullptr;
   std::unique_ptr<GameLoop> gameLoopView = nullptr;
+  std::unique_ptr<StressTest> stressTestView = nullptr;
 
   bool debugMode = false;
   bool fullscreen = false;
@@ -44,8 +65,11 @@ class Game {
   void update(float deltaTime);
 
   void render();
+  void presentScene();
   void renderUI();
   void renderDebug();
 
   void changeGameState(GameState);
+  void writeFrameReport();
+  void publishLiveState(double frameMs, double updateMs, double renderMs);
 };
\ No newline at end of file
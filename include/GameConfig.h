@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 class GameConfig {
  public:
   // Logical rendering dimensions
@@ -11,6 +13,13 @@ class GameConfig {
   static constexpr int DEFAULT_WINDOW_WIDTH = LOGICAL_WIDTH * DEFAULT_WINDOW_SCALE;
   static constexpr int DEFAULT_WINDOW_HEIGHT = LOGICAL_HEIGHT * DEFAULT_WINDOW_SCALE;
 
+  // Stage dimensions in world units, wider than the screen so the camera has room to pan
+  static constexpr int STAGE_WIDTH = LOGICAL_WIDTH * 2;
+  static constexpr int STAGE_HEIGHT = LOGICAL_HEIGHT;
+
+  // Upper bound for textures kept resident after their last user is gone
+  static constexpr size_t TEXTURE_BUDGET_BYTES = 64 * 1024 * 1024;
+
   // Game constants
   static constexpr float PLAYER1_X_RATIO = 0.2f;
   static constexpr float PLAYER2_X_RATIO = 0.8f;
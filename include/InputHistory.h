@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "managers/InputManager.h"
+
+// Action bits of one player for each of the last CAPACITY simulation ticks
+class InputHistory {
+ public:
+  static constexpr size_t CAPACITY = 64;  // about a second at 60 ticks per second
+
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+  static_assert(static_cast<size_t>(PlayerAction::COUNT) <= 8, "action bits must fit in a byte");
+
+  void push(uint8_t actionBits) {
+    head = (head + 1) & (CAPACITY - 1);
+    ticks[head] = actionBits;
+    ++recordedTicks;
+  }
+
+  // 0 is the current tick, ticks older than the history read as no input
+  uint8_t get(size_t ticksAgo) const {
+    if (ticksAgo >= CAPACITY || ticksAgo >= recordedTicks)
+      return 0;
+    return ticks[(head - ticksAgo) & (CAPACITY - 1)];
+  }
+
+  static bool isSet(uint8_t actionBits, PlayerAction action) {
+    return (actionBits >> static_cast<uint8_t>(action)) & 1;
+  }
+
+  // Pressed on the current tick but not on the one before
+  bool wasPressed(PlayerAction action) const {
+    return isSet(get(0), action) && !isSet(get(1), action);
+  }
+
+ private:
+  std::array<uint8_t, CAPACITY> ticks{};
+  size_t head = 0;
+  size_t recordedTicks = 0;
+};
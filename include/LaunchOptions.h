@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+struct LaunchOptions {
+  // --renderer=<name>, forces a render driver and skips the cached choice
+  std::string rendererName;
+  // --list-renderers
+  bool listRenderers = false;
+  // --benchmark-renderers, benchmarks every driver and caches the fastest
+  bool benchmarkRenderers = false;
+  // --no-cooked-assets, loads the PNGs even when cooked textures are packed, to compare load times
+  bool useCookedAssets = true;
+  // --hot-reload, reloads textures from resources/ when they change on disk
+  bool hotReload = false;
+  // --texture-budget=<megabytes>, overrides GameConfig::TEXTURE_BUDGET_BYTES
+  int textureBudgetMegabytes = 0;
+  // --startup-trace, prints a per-phase timing breakdown up to the first presented frame
+  bool startupTrace = false;
+  // --trace=<file>, writes profiler zones and frames as Chrome trace-event JSON
+  std::string traceFile;
+  // --frame-report=<file.json|file.csv>, frame time percentiles written at exit and on F9
+  std::string frameReportFile;
+  // --stress=<fighters>, skips the menu and ramps AI fighters up to this count, timings go to stress_report.csv
+  int stressFighterCount = 0;
+  // --alloc-asserts, aborts on the first heap allocation inside a NO_ALLOC_SCOPE instead of only logging it
+  bool allocAsserts = false;
+  // --live-state[=<name>], publishes player, collision and timing state to shared memory for tools/LiveStateInspector
+  std::string liveStateName;
+
+  static LaunchOptions parse(int argc, char *argv[]);
+};
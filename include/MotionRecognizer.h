@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "InputHistory.h"
+
+enum class SpecialMove : uint8_t {
+  NONE = 0,
+  LUNGE_PUNCH,   // quarter circle forward + punch
+  RETREAT_PUNCH  // quarter circle back + punch
+};
+
+const char *getSpecialMoveName(SpecialMove move);
+
+// Directions in numpad notation relative to the facing of the player, then the buttons
+enum class MotionSymbol : uint8_t {
+  DOWN_BACK = 0,  // 1
+  DOWN,           // 2
+  DOWN_FORWARD,   // 3
+  BACK,           // 4
+  NEUTRAL,        // 5
+  FORWARD,        // 6
+  UP_BACK,        // 7
+  UP,             // 8
+  UP_FORWARD,     // 9
+  PUNCH,
+  COUNT
+};
+
+// All motions share one automaton, so a tick costs the same however long the move list is
+class MotionRecognizer {
+ public:
+  using StateId = uint16_t;
+
+  // Per player progress through the automaton
+  struct Tracker {
+    StateId state = 0;
+    MotionSymbol lastDirection = MotionSymbol::NEUTRAL;
+    uint16_t ticksSinceSymbol = 0;
+  };
+
+  // Symbols of a motion may be at most this many ticks apart
+  static constexpr uint16_t MOTION_WINDOW_TICKS = 12;
+
+  static MotionRecognizer createMoveList();
+
+  // When motions overlap, the longer one wins
+  void addMotion(SpecialMove move, std::initializer_list<MotionSymbol> sequence);
+
+  // Builds the trie of all motions and flattens it with its failure links into a [state][symbol] -> state table
+  void compile();
+
+  // Feeds the latest tick of the history, returns the move completed on it
+  SpecialMove step(Tracker &tracker, const InputHistory &history, float facing) const;
+
+  size_t getStateCount() const { return outputs.size(); }
+
+ private:
+  static constexpr size_t SYMBOL_COUNT = static_cast<size_t>(MotionSymbol::COUNT);
+
+  struct Motion {
+    SpecialMove move;
+    std::vector<MotionSymbol> sequence;
+  };
+
+  static MotionSymbol directionSymbol(uint8_t actionBits, float facing);
+
+  SpecialMove feed(Tracker &tracker, MotionSymbol symbol) const;
+
+  std::vector<Motion> motions;
+  std::vector<StateId> transitionTable;
+  std::vector<SpecialMove> outputs;
+};
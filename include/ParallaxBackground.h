@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "utils/SDLDeleter.h"
+
+struct ParallaxLayer {
+  // Pre-composited at load, logical resolution sized and horizontally seamless
+  unique_texture texture;
+
+  float scrollFactor;     // 0 = fixed to the screen, 1 = moves with the world
+  float autoScrollSpeed;  // pixels per second, independent of the camera
+  float autoScrollOffset;
+};
+
+class ParallaxBackground {
+ public:
+  using ComposeFunction = std::function<void(SDL_Renderer *renderer, int width, int height)>;
+
+  ParallaxBackground(SDL_Renderer *renderer);
+  ~ParallaxBackground();
+
+  static std::unique_ptr<ParallaxBackground> createStage(SDL_Renderer *renderer);
+  static std::unique_ptr<ParallaxBackground> createMainMenu(SDL_Renderer *renderer);
+
+  // Layers are added far to near, compose draws the layer once into its texture
+  bool addLayer(float scrollFactor, float autoScrollSpeed, const ComposeFunction &compose);
+
+  void update(float deltaTime);
+  void setScroll(float worldX) { scrollX = worldX; }
+
+  // One wrapped textured quad per layer
+  void render() const;
+
+ private:
+  SDL_Renderer *renderer;
+  std::vector<ParallaxLayer> layers;
+  float scrollX = 0.0f;
+};
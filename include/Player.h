@@ -4,9 +4,13 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "Animation.h"
+#include "AnimationStateMachine.h"
+#include "MotionRecognizer.h"
+#include "managers/ResourceManager.h"
 #include "utils/SDLDeleter.h"
 
 class Player {
@@ -15,14 +19,13 @@ class Player {
   ~Player();
 
   void update(float deltaTime);
-  void render(SDL_Renderer *renderer);
+  void render();
 
-  void setAnimation(int animationIndex);
-  int getCurrentAnimation() const { return currentAnimation; }
-
-  void playIdleAnimation() { setAnimation(0); }
-  void playRunAnimation() { setAnimation(1); }
-  void playTakingPunchAnimation() { setAnimation(2); }
+  // Feeds a one-shot condition such as HIT into the animation state machine
+  void triggerAnimation(AnimationCondition trigger);
+  PlayerAnimState getCurrentAnimation() const { return static_cast<PlayerAnimState>(animState); }
+  int getAnimationFrame() const { return playhead.currentFrame(); }
+  const std::string &getCurrentAnimationName() const { return stateMachine->getState(animState).name; }
 
   bool isPlayerGrounded() const { return isGrounded; }
 
@@ -30,13 +33,18 @@ class Player {
   void jump();
   void punch();
   void stopMoving();
+  // facing is towards the opponent, the player turns to it for the punch
+  void performSpecial(SpecialMove move, float facing);
+  SpecialMove getLastSpecial() const { return lastSpecial; }
 
   glm::vec2 getPosition() const { return position; }
   void setPosition(const glm::vec2 &newPosition) {
     position = newPosition;
     velocity *= 0.8f;
   }
+  glm::vec2 getVelocity() const { return velocity; }
   bool isMoving() const { return velocity.x != 0; }
+  float getDirection() const { return direction; }
 
   SDL_FRect getWorldHitbox() const;
   SDL_FRect getAttackBox() const;
@@ -45,10 +53,13 @@ class Player {
   SDL_FRect getLocalHitbox() const { return hitbox; }
 
  private:
-  shared_texture idleTexture;
-  shared_texture runTexture;
-  shared_texture takingPunchTexture;
+  using StateId = AnimationStateMachine::StateId;
+
+  void enterState(StateId state);
+  void resolveHitbox();
+
   SDL_FRect hitbox;
+  bool hitboxResolved;
 
   glm::vec2 position, velocity;
 
@@ -58,9 +69,16 @@ class Player {
   bool isGrounded;
   bool isActivelyMoving;
 
-  std::vector<Animation> animations;
-  int currentAnimation;
-  int spriteFrame;
+  // Movement input is ignored while a special carries the player
+  float specialTimeLeft = 0.0f;
+  SpecialMove lastSpecial = SpecialMove::NONE;
+
+  // Shared state machine and clips owned by ResourceManager, only the state and playhead are per player
+  const AnimationStateMachine *stateMachine;
+  std::vector<TextureHandle> stateTextures;
+  StateId animState;
+  AnimationPlayhead playhead;
+  uint8_t pendingTriggers;
 
   bool primaryPlayer;
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include <array>
+#include <memory>
+#include <string_view>
+
+#include "managers/RenderManager.h"
+#include "utils/SDLDeleter.h"
+
+struct SDFGlyph {
+  SDL_FRect src;  // atlas rect, at the rasterisation size
+  float advance;
+  bool valid;
+};
+
+// Printable ASCII rasterised once as signed distance fields into a single texture.
+// Text of any size is drawn as scaled quads from it with linear filtering.
+class SDFFontAtlas {
+ public:
+  static constexpr char FIRST_GLYPH = ' ';
+  static constexpr char LAST_GLYPH = '~';
+
+  // Rasterises and packs the glyphs on the CPU, safe off the render thread.
+  // font must have SDF rendering enabled, it is only used while building.
+  static std::unique_ptr<SDFFontAtlas> build(TTF_Font *font, float rasterSize);
+
+  // Creates the texture from the packed glyphs, render thread only
+  bool upload(SDL_Renderer *renderer);
+  bool isUploaded() const { return texture != nullptr; }
+
+  void drawText(RenderLayer layer, float x, float y, std::string_view text, float size, SDL_Color color,
+                float depth = 0.0f) const;
+  SDL_FPoint measureText(std::string_view text, float size) const;
+
+  SDL_Texture *getTexture() const { return texture.get(); }
+
+ private:
+  SDFFontAtlas() = default;
+
+  const SDFGlyph *findGlyph(char c) const;
+
+  unique_surface atlasSurface;
+  unique_texture texture;
+  std::array<SDFGlyph, LAST_GLYPH - FIRST_GLYPH + 1> glyphs{};
+  float rasterSize = 0.0f;
+  float lineHeight = 0.0f;
+};
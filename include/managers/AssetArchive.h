@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct AssetView {
+  const uint8_t *data;
+  size_t size;
+};
+
+// Read-only view over a memory-mapped resources.pak. Lookups never copy, the returned
+// views point straight into the mapping and stay valid until close().
+// Safe to read from several threads once open() has returned.
+class AssetArchive {
+ public:
+  AssetArchive();
+  ~AssetArchive();
+
+  AssetArchive(const AssetArchive &) = delete;
+  AssetArchive &operator=(const AssetArchive &) = delete;
+
+  bool open(const std::string &archivePath);
+  void close();
+
+  bool isOpen() const { return mappedData != nullptr; }
+  size_t getAssetCount() const { return assets.size(); }
+
+  bool find(std::string_view path, AssetView &view) const;
+
+  // A stream over the archived bytes, or the loose file when the asset isn't packed.
+  // The caller owns the stream and should hand it to SDL with closeio = true.
+  SDL_IOStream *openIO(const std::string &path) const;
+
+ private:
+  bool mapFile(const std::string &archivePath);
+  void unmapFile();
+  bool readIndex();
+
+  const uint8_t *mappedData = nullptr;
+  size_t mappedSize = 0;
+
+#ifdef _WIN32
+  void *fileHandle = nullptr;
+  void *mappingHandle = nullptr;
+#else
+  int fileDescriptor = -1;
+#endif
+
+  // Keys view the path table inside the mapping
+  std::unordered_map<std::string_view, AssetView> assets;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Watches a directory tree for rewritten files on a background thread.
+// Only implemented with inotify, start() fails on other platforms.
+class AssetWatcher {
+ public:
+  // Called on the watcher thread with the changed file path, relative like the watched root
+  using ChangeCallback = std::function<void(const std::string &path)>;
+
+  AssetWatcher();
+  ~AssetWatcher();
+
+  AssetWatcher(const AssetWatcher &) = delete;
+  AssetWatcher &operator=(const AssetWatcher &) = delete;
+
+  bool start(const std::string &rootDirectory, ChangeCallback onChanged);
+  void stop();
+
+  bool isRunning() const { return running; }
+
+ private:
+  void watchLoop();
+  void addWatchRecursive(const std::string &directory);
+
+  ChangeCallback onChanged;
+  std::thread watchThread;
+  std::atomic<bool> running = false;
+
+  int inotifyDescriptor = -1;
+  std::unordered_map<int, std::string> watchedDirectories;
+};
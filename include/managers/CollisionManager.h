@@ -65,6 +65,7 @@ class CollisionManager {
   SDL_FRect getWorldBounds() const { return worldBounds; }
 
   bool checkCollision(const SDL_FRect &a, const SDL_FRect &b) const;
+  bool checkAABBCollision(const SDL_FRect &a, const SDL_FRect &b, CollisionInfo *info = nullptr) const;
   bool checkPointInRect(const glm::vec2 &point, const SDL_FRect &rect) const;
   std::vector<std::shared_ptr<ICollidable>> getCollidablesInArea(const SDL_FRect &area) const;
 
@@ -72,7 +73,9 @@ class CollisionManager {
   void resolvePlayerBoundaryCollision(Player *player, const SDL_FRect &boundary);
   void resolveAttackHit(Player *attacker, Player *defender);
 
-  std::vector<CollisionInfo> getLastFrameCollisions() const { return lastFrameCollisions; }
+  // Clears the collisions recorded last frame, the capacity is kept
+  void beginFrame() { lastFrameCollisions.clear(); }
+  const std::vector<CollisionInfo> &getLastFrameCollisions() const { return lastFrameCollisions; }
   void setDebugVisualization(bool enabled) { debugVisualization = enabled; }
   bool isDebugVisualizationEnabled() const { return debugVisualization; }
 
@@ -80,12 +83,11 @@ class CollisionManager {
   void setOnBoundaryHitCallback(std::function<void(Player *)> callback);
 
  private:
-  CollisionManager() = default;
+  CollisionManager() { lastFrameCollisions.reserve(EXPECTED_COLLISIONS_PER_FRAME); }
   ~CollisionManager() = default;
   CollisionManager(const CollisionManager &) = delete;
   CollisionManager &operator=(const CollisionManager &) = delete;
 
-  bool checkAABBCollision(const SDL_FRect &a, const SDL_FRect &b, CollisionInfo *info = nullptr) const;
   bool checkCircleCollision(const glm::vec2 &centerA, float radiusA,
                             const glm::vec2 &centerB, float radiusB) const;
 
@@ -102,4 +104,5 @@ class CollisionManager {
 
   static constexpr float COLLISION_EPSILON = 0.001f;
   static constexpr int MAX_COLLISION_ITERATIONS = 4;
+  static constexpr size_t EXPECTED_COLLISIONS_PER_FRAME = 32;
 };
\ No newline at end of file
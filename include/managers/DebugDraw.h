@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <atomic>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// Immediate mode debug shapes in world coordinates. Anything may draw during the frame, the shapes are
+// collected into one vertex buffer and go out as a single SDL_RenderGeometry call in the WORLD_DEBUG layer.
+// Drawing is ignored while debug mode is off.
+class DebugDraw {
+ public:
+  static DebugDraw &getInstance();
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+  void fillRect(const SDL_FRect &rect, SDL_Color color);
+  void rect(const SDL_FRect &rect, SDL_Color color, float thickness = 1.0f);
+  void line(glm::vec2 from, glm::vec2 to, SDL_Color color, float thickness = 1.0f);
+  void circle(glm::vec2 center, float radius, SDL_Color color, float thickness = 1.0f);
+  void arrow(glm::vec2 from, glm::vec2 to, SDL_Color color, float thickness = 1.0f);
+  // Drawn with the SDL debug font, which cannot share the geometry call
+  void text(glm::vec2 position, std::string_view message, SDL_Color color);
+
+  // Render thread, once per frame before RenderManager::flush(). Moves everything drawn so far into
+  // screen space with the current camera, the submitted buffers stay alive until the next submit.
+  void submit();
+
+  size_t getLastFrameVertexCount() const { return lastFrameVertexCount; }
+
+  static constexpr int CIRCLE_SEGMENTS = 16;
+  static constexpr float ARROW_HEAD_SIZE = 6.0f;
+
+ private:
+  DebugDraw();
+  ~DebugDraw() = default;
+  DebugDraw(const DebugDraw &) = delete;
+  DebugDraw &operator=(const DebugDraw &) = delete;
+
+  struct TextEntry {
+    glm::vec2 position;
+    size_t offset;  // into textChars, null terminated
+    SDL_Color color;
+  };
+
+  // Callers hold the mutex
+  void addQuad(glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d, SDL_Color color);
+  void addLine(glm::vec2 from, glm::vec2 to, SDL_Color color, float thickness);
+
+  std::atomic<bool> enabled{false};
+
+  std::mutex mutex;
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+  std::vector<TextEntry> texts;
+  std::vector<char> textChars;
+
+  std::vector<SDL_Vertex> submittedVertices;
+  std::vector<int> submittedIndices;
+  std::vector<char> submittedChars;
+
+  size_t lastFrameVertexCount = 0;
+
+  static constexpr size_t INITIAL_VERTEX_CAPACITY = 4096;
+};
@@ -16,10 +16,11 @@ class DebugManager {
   static DebugManager &getInstance();
 
   void initialize(SDL_Renderer *renderer);
-  void setDebugMode(bool enabled) { debugMode = enabled; }
+  // Also switches DebugDraw on and off
+  void setDebugMode(bool enabled);
   bool isDebugMode() const { return debugMode; }
 
-  void render(SDL_Renderer *renderer);
+  void render();
   void clear();
 
   void debugPlayer(const Player *player, const std::string &playerName);
@@ -28,12 +29,19 @@ class DebugManager {
   void debugCursorPosition(float x, float y);
   void debugCollisionManager();
 
+  // Rolling per-zone bar graph in the top right corner, min/avg/max over Profiler::HISTORY_FRAMES
+  void debugProfiler();
+
+  // Heap allocations of the last frame on the main thread and per profiler zone
+  void debugAllocations();
+
   void addDebugText(const std::string &text);
   void addDebugValue(const std::string &name, float value);
   void addDebugValue(const std::string &name, int value);
   void addDebugValue(const std::string &name, bool value);
 
-  void renderCollisionBoxes(SDL_Renderer *renderer, const Player *player1, const Player *player2);
+  // Hitboxes, attack boxes, world bounds and the contact normals of the last collision pass
+  void renderCollisionBoxes(const Player *player1, const Player *player2);
 
  private:
   DebugManager() = default;
@@ -49,6 +57,7 @@ class DebugManager {
   struct DebugLine {
     std::string text;
     int yOffset;
+    float x = 5.0f;
   };
 
   std::vector<DebugLine> debugLines;
@@ -2,23 +2,52 @@
 
 #include <SDL3_ttf/SDL_ttf.h>
 
+#include <future>
 #include <map>
+#include <memory>
 #include <string>
 
+#include "SDFFontAtlas.h"
+#include "managers/AssetArchive.h"
 #include "utils/SDLDeleter.h"
 
 class FontManager {
  public:
+  // Size the SDF atlas is rasterised at, text at any other size is scaled from it
+  static constexpr float SDF_RASTER_SIZE = 48.0f;
+
   FontManager();
   ~FontManager();
 
-  bool initialize();
+  // Fonts are opened from the archive when packed, the archive must outlive the fonts
+  bool initialize(const AssetArchive *archive = nullptr);
   void cleanup();
 
-  TTF_Font *getFont(int size) const;
+  // Nothing is opened until the first getFont() or getAtlas()
+  void setDefaultFont(const std::string &fontPath) { defaultFontPath = fontPath; }
+
+  // Opens the default font at this size on first use
+  TTF_Font *getFont(int size);
   bool loadFont(const std::string &fontPath, int size);
 
+  // Rasterises the atlas ahead of time on the calling thread, nothing else may use
+  // SDL_ttf until it returns
+  void prepareAtlas();
+
+  // Built from the default font on first use, nullptr if that failed.
+  // Waits for a prepareAtlas() running on another thread.
+  const SDFFontAtlas *getAtlas(SDL_Renderer *renderer);
+  void setAtlasPreparation(std::future<void> preparation) { atlasPreparation = std::move(preparation); }
+
  private:
+  TTF_Font *openFont(const std::string &fontPath, float size) const;
+
   std::map<int, shared_font> fonts;
   std::string defaultFontPath;
-};
\ No newline at end of file
+  const AssetArchive *archive = nullptr;
+
+  std::unique_ptr<SDFFontAtlas> atlas;
+  std::future<void> atlasPreparation;
+  bool atlasFailed = false;
+  bool loggedAtlasFailure = false;
+};
@@ -2,8 +2,10 @@
 
 #include <SDL3/SDL.h>
 
+#include <array>
 #include <bitset>
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
 #include "glm/glm.hpp"
 
@@ -12,6 +14,7 @@ enum class PlayerAction {
   MoveRight,
   Jump,
   Punch,
+  Crouch,
   COUNT  // total number of actions
 };
 
@@ -21,24 +24,66 @@ enum class PlayerId {
   COUNT
 };
 
+// One press or release of a mapped key, followed from the event to the frame that showed its effect
+struct InputTransition {
+  PlayerId playerId;
+  PlayerAction action;
+  bool pressed;
+  Uint64 eventNs;           // SDL event timestamp, same clock as SDL_GetTicksNS()
+  uint64_t appliedTick = 0; // simulation tick that first saw the new state
+  Uint64 presentedNs = 0;
+};
+
 class InputManager {
  public:
+  static constexpr size_t LATENCY_SAMPLE_COUNT = 256;
+
   bool primary = false;
 
   void initProcessSession();
-  void processEvent(SDL_Event event);
+  void processEvent(const SDL_Event &event);
+
+  // Called after the simulation tick that consumed this frame's input, then once the frame is presented
+  void markApplied(uint64_t tick);
+  void markPresented(Uint64 presentNs);
 
   bool isActionPressed(PlayerId playerId, PlayerAction action) const;
 
   bool isKeyPressing(PlayerId playerId) const;
 
+  // Bit n set while PlayerAction n is held
+  uint8_t getActionBits(PlayerId playerId) const {
+    return static_cast<uint8_t>(playerStates[static_cast<size_t>(playerId)].to_ulong());
+  }
+
   glm::vec2 getCursorPosition(SDL_Renderer *renderer) const;
 
+  // Input-to-present latency over the last LATENCY_SAMPLE_COUNT transitions, 0 until one was presented
+  double getLatencyPercentileMs(double percentile) const;
+  size_t getLatencySampleCount() const { return latencySampleCount; }
+  const std::vector<InputTransition> &getLastPresentedTransitions() const { return presentedTransitions; }
+
  private:
+  struct KeyBinding {
+    bool bound = false;
+    PlayerId playerId = PlayerId::Player1;
+    PlayerAction action = PlayerAction::MoveLeft;
+  };
+
   std::bitset<static_cast<size_t>(PlayerAction::COUNT)> playerStates[static_cast<size_t>(PlayerId::COUNT)];
 
-  // Key map
-  static const std::unordered_map<SDL_Keycode, std::pair<PlayerId, PlayerAction>> keyMappings;
+  // Key map, indexed by physical key
+  static const std::array<KeyBinding, SDL_SCANCODE_COUNT> keyBindings;
+
+  // Transitions waiting for their tick, then for their frame to be presented
+  std::vector<InputTransition> pendingTransitions;
+  std::vector<InputTransition> presentedTransitions;
+
+  std::array<double, LATENCY_SAMPLE_COUNT> latencySamplesMs{};
+  size_t latencySampleCount = 0;
+  size_t nextLatencySample = 0;
+
+  static std::array<KeyBinding, SDL_SCANCODE_COUNT> buildKeyBindings();
 
   void setActionState(PlayerId playerId, PlayerAction action, bool isPressed);
-};
\ No newline at end of file
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+#include "utils/LiveStateFormat.h"
+
+// Publishes a LiveStateFormat::Snapshot into a named shared memory segment once per tick,
+// for tools/LiveStateInspector. Publishing is a single memcpy, the game never waits for readers.
+class LiveStatePublisher {
+ public:
+  LiveStatePublisher() = default;
+  ~LiveStatePublisher();
+
+  LiveStatePublisher(const LiveStatePublisher &) = delete;
+  LiveStatePublisher &operator=(const LiveStatePublisher &) = delete;
+
+  // Creates the segment, or takes over one left behind by a previous run
+  bool open(const std::string &segmentName);
+
+  // Unmaps and removes the segment
+  void close();
+
+  bool isOpen() const { return segment != nullptr; }
+
+  void publish(const LiveStateFormat::Snapshot &snapshot) {
+    if (segment)
+      LiveStateFormat::writeSnapshot(*segment, snapshot);
+  }
+
+ private:
+  // Platform specific, set segment and name on success
+  bool mapSegment(const std::string &segmentName);
+  void unmapSegment();
+
+  LiveStateFormat::Segment *segment = nullptr;
+  std::string name;
+
+#ifdef _WIN32
+  void *mappingHandle = nullptr;
+#endif
+};
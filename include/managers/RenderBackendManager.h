@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <string>
+#include <vector>
+
+#include "LaunchOptions.h"
+
+struct BackendBenchmarkResult {
+  std::string driverName;
+  bool created;
+  double spriteFramesPerSecond;
+  double textFramesPerSecond;
+
+  // Mixed frame rate derived from both passes, used to rank the drivers
+  double score() const;
+};
+
+class RenderBackendManager {
+ public:
+  static RenderBackendManager &getInstance();
+
+  std::vector<std::string> getAvailableDrivers() const;
+  bool isDriverAvailable(const std::string &driverName) const;
+
+  // Forced driver, then fresh benchmark, then cached choice. Empty means let SDL pick.
+  std::string selectBackend(SDL_Window *window, const LaunchOptions &options);
+
+  // Creates a throwaway renderer per driver on the window, including the software renderer
+  std::vector<BackendBenchmarkResult> benchmarkAll(SDL_Window *window) const;
+  BackendBenchmarkResult benchmarkDriver(SDL_Window *window, const std::string &driverName) const;
+
+  std::string loadCachedBackend() const;
+  bool saveCachedBackend(const std::string &driverName) const;
+
+ private:
+  RenderBackendManager() = default;
+  ~RenderBackendManager() = default;
+  RenderBackendManager(const RenderBackendManager &) = delete;
+  RenderBackendManager &operator=(const RenderBackendManager &) = delete;
+
+  std::string getConfigPath() const;
+
+  static constexpr int BENCHMARK_FRAMES = 90;
+  static constexpr int BENCHMARK_SPRITES = 2000;
+  static constexpr int BENCHMARK_TEXT_LINES = 200;
+};
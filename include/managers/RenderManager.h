@@ -0,0 +1,153 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class Camera;
+
+// Draw order, lowest first. The layer is the most significant part of the sort key.
+// Values between BACKGROUND and WORLD are parallax layers, far to near (see backgroundLayer()).
+enum class RenderLayer : uint8_t {
+  BACKGROUND = 0,
+  WORLD = 8,
+  WORLD_DEBUG,
+  UI,
+  DEBUG_OVERLAY
+};
+
+inline RenderLayer backgroundLayer(int depthIndex) {
+  int maxIndex = static_cast<int>(RenderLayer::WORLD) - 1;
+  return static_cast<RenderLayer>(depthIndex < 0 ? 0 : (depthIndex > maxIndex ? maxIndex : depthIndex));
+}
+
+enum class RenderCommandType : uint8_t {
+  TEXTURE,
+  TEXTURE_WRAPPED,
+  FILL_RECT,
+  RECT,
+  DEBUG_TEXT,
+  GEOMETRY
+};
+
+struct RenderCommand {
+  RenderCommandType type;
+  SDL_BlendMode blendMode;
+  SDL_Texture *texture;
+  // TEXTURE_WRAPPED uses src.x as the horizontal scroll offset in texels
+  SDL_FRect src;
+  SDL_FRect dst;
+  SDL_Color color;
+  SDL_FlipMode flip;
+  bool hasSrc;
+  // DEBUG_TEXT only, must stay alive until flush()
+  const char *text;
+  // GEOMETRY only, untextured and already in screen space, must stay alive until flush()
+  const SDL_Vertex *vertices;
+  const int *indices;
+  int vertexCount;
+  int indexCount;
+};
+
+class RenderManager {
+ public:
+  static RenderManager &getInstance();
+
+  void initialize(SDL_Renderer *renderer);
+  void cleanup();
+
+  // Sort key layout (most significant first):
+  // layer (8 bits) | blend mode (4 bits) | texture id (20 bits) | depth (32 bits)
+  // except in depth sorted layers, where overlap order matters more than batching:
+  // layer (8 bits) | depth (32 bits) | blend mode (4 bits) | texture id (20 bits)
+  static uint64_t makeSortKey(RenderLayer layer, SDL_BlendMode blendMode, uint32_t textureId, float depth);
+
+  // Submission is thread-safe, commands are only executed by flush() on the render thread
+  void submit(const RenderCommand &command, RenderLayer layer, float depth = 0.0f);
+  void submitBatch(const std::vector<RenderCommand> &commands, RenderLayer layer, float depth = 0.0f);
+
+  // color modulates the texture, white draws it unchanged
+  void drawTexture(RenderLayer layer, SDL_Texture *texture, const SDL_FRect *src, const SDL_FRect &dst,
+                   float depth = 0.0f, SDL_FlipMode flip = SDL_FLIP_NONE, SDL_Color color = {255, 255, 255, 255});
+  // Draws the whole texture into dst scrolled horizontally by offsetX, wrapping around its edge
+  void drawTextureWrapped(RenderLayer layer, SDL_Texture *texture, float offsetX, const SDL_FRect &dst);
+  void fillRect(RenderLayer layer, const SDL_FRect &rect, SDL_Color color,
+                SDL_BlendMode blendMode = SDL_BLENDMODE_NONE, float depth = 0.0f);
+  void drawRect(RenderLayer layer, const SDL_FRect &rect, SDL_Color color,
+                SDL_BlendMode blendMode = SDL_BLENDMODE_NONE, float depth = 0.0f);
+  void drawDebugText(RenderLayer layer, float x, float y, const char *text, SDL_Color color);
+  // Vertex coloured triangles, never transformed by the camera even in world layers
+  void drawGeometry(RenderLayer layer, const SDL_Vertex *vertices, int vertexCount, const int *indices,
+                    int indexCount, SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+
+  struct ViewTransform {
+    SDL_FRect viewRect;
+    float zoom;
+    bool enabled;
+  };
+
+  // The camera world layers are drawn with, screen = (world - viewRect origin) * zoom while enabled
+  ViewTransform getViewTransform();
+
+  // World layers (WORLD, WORLD_DEBUG) are culled against the camera view and transformed to
+  // screen space at submission, so off-screen commands never reach the queue
+  void setCamera(const Camera &camera);
+  void resetCamera();
+
+  // Sorts the queued commands, executes them and empties the queue
+  void flush();
+
+  size_t getLastFrameCommandCount() const { return lastFrameCommandCount; }
+  size_t getLastFrameStateChanges() const { return lastFrameStateChanges; }
+  size_t getLastFrameCulledCount() const { return lastFrameCulledCount; }
+
+ private:
+  RenderManager() = default;
+  ~RenderManager() = default;
+  RenderManager(const RenderManager &) = delete;
+  RenderManager &operator=(const RenderManager &) = delete;
+
+  struct SortEntry {
+    uint64_t key;
+    uint32_t index;
+  };
+
+  // Fighters are ordered by their feet, whatever sprite sheet they are drawn from
+  static bool isDepthSortedLayer(RenderLayer layer) { return layer == RenderLayer::WORLD; }
+
+  static bool isWorldLayer(RenderLayer layer) {
+    return layer == RenderLayer::WORLD || layer == RenderLayer::WORLD_DEBUG;
+  }
+
+  // Returns false if the command is outside the view and should be dropped
+  bool toScreenSpace(RenderCommand &command) const;
+  void enqueue(const RenderCommand &command, RenderLayer layer, float depth);
+  uint32_t getTextureId(SDL_Texture *texture);
+  void radixSort();
+  void execute();
+  void renderWrapped(const RenderCommand &command);
+
+  SDL_Renderer *renderer = nullptr;
+  bool textureWrapping = false;
+
+  std::mutex queueMutex;
+  std::vector<RenderCommand> commands;
+  std::vector<SortEntry> sortEntries;
+  std::vector<SortEntry> sortScratch;
+  std::vector<SDL_FRect> rectBatch;
+
+  std::unordered_map<SDL_Texture *, uint32_t> textureIds;
+  uint32_t nextTextureId = 1;
+
+  size_t lastFrameCommandCount = 0;
+  size_t lastFrameStateChanges = 0;
+  size_t lastFrameCulledCount = 0;
+  size_t culledCount = 0;
+
+  ViewTransform view = {{0, 0, 0, 0}, 1.0f, false};
+
+  static constexpr uint32_t TEXTURE_ID_MASK = (1u << 20) - 1;
+};
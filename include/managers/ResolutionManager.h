@@ -36,6 +36,18 @@ class ResolutionManager {
 
   Resolution getClosestPixelPerfectResolution(int width, int height) const;
 
+  // Largest whole-number scale of the logical resolution that fits the output (at least 1)
+  int getIntegerScale(int outputWidth, int outputHeight) const;
+
+  // Where the logical render target lands in the output, centered with the remainder letterboxed.
+  // Falls back to a fractional downscale only if the output is smaller than the logical resolution.
+  SDL_FRect getPresentationRect(int outputWidth, int outputHeight) const;
+
+  // True when the scene is drawn into an offscreen target and upscaled by hand. Otherwise SDL's logical
+  // presentation does the scaling, and renderer coordinates are already logical.
+  void setOffscreenPresentation(bool offscreen) { offscreenPresentation = offscreen; }
+  bool usesOffscreenPresentation() const { return offscreenPresentation; }
+
   void toggleFullscreen(SDL_Window *window);
   void setFullscreen(SDL_Window *window, bool fullscreen);
   bool isFullscreen() const;
@@ -49,6 +61,7 @@ class ResolutionManager {
   Resolution windowedResolution{1280, 720};
   std::vector<Resolution> availableResolutions;
   bool isCurrentlyFullscreen = false;
+  bool offscreenPresentation = false;
 
   void generateAvailableResolutions();
 };
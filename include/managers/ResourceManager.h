@@ -3,16 +3,25 @@
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 
+#include <deque>
 #include <format>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "Animation.h"
+#include "AnimationStateMachine.h"
+#include "GameConfig.h"
+#include "managers/AssetArchive.h"
+#include "managers/AssetWatcher.h"
 #include "managers/FontManager.h"
+#include "managers/TextureHandle.h"
+#include "managers/TextureResidency.h"
 #include "utils/SDLDeleter.h"
+#include "utils/ThreadPool.h"
 
 enum class AnimationType {
   PLAYER1_IDLE = 0,
@@ -23,6 +32,23 @@ enum class AnimationType {
   PLAYER2_TAKING_PUNCH = 5
 };
 
+// State ids of the player state machine, in the order they are added
+enum class PlayerAnimState : uint8_t {
+  IDLE = 0,
+  RUN = 1,
+  TAKING_PUNCH = 2
+};
+
+// Timings of the last batch of texture loads, from the first request until the queue drained
+struct TextureLoadStats {
+  Uint64 startCounter = 0;
+  size_t textureCount = 0;
+  size_t cookedCount = 0;
+  double wallMs = 0.0;
+  double decodeMs = 0.0;  // summed over the worker threads
+  double uploadMs = 0.0;
+};
+
 class ResourceManager {
  public:
   // Singleton access
@@ -31,16 +57,43 @@ class ResourceManager {
     return instance;
   }
 
-  bool initialize(SDL_Renderer *renderer);
+  // Needs no renderer, so it can run while the window and renderer are still being created.
+  // Texture decoding starts immediately, uploads begin once a renderer is attached.
+  bool initialize();
+  void attachRenderer(SDL_Renderer *renderer);
 
   void cleanup();
 
-  shared_texture getTexture(const std::string &path);
+  // Returns immediately, the image is decoded on a worker thread and the handle
+  // resolves once processUploads() has created the texture
+  TextureHandle getTexture(AssetId id);
+
+  // Uploads decoded images on the render thread until the time budget is spent
+  void processUploads(double budgetMs);
+
+  bool isLoading() const { return texturesCompleted < texturesRequested; }
+  float getLoadProgress() const;
+
+  // Cooked .tex blobs from the archive are preferred over PNGs unless disabled,
+  // must be set before initialize() to affect the preloaded textures
+  void setUseCookedAssets(bool useCooked) { useCookedAssets = useCooked; }
+  const TextureLoadStats &getLastLoadStats() const { return loadStats; }
+
+  // Watches resources/ and swaps changed textures behind their existing handles,
+  // must be set before initialize()
+  void setHotReload(bool enabled) { hotReload = enabled; }
+
+  // Textures without handles stay resident until this many bytes are used
+  void setTextureBudget(size_t bytes) { residency.setBudget(bytes); }
+  const TextureResidency &getResidency() const { return residency; }
 
-  const Animation &getAnimation(AnimationType type) const;
-  std::vector<Animation> getPlayerAnimations(bool isPrimaryPlayer) const;
+  // Clips live here for the lifetime of the manager, entities keep pointers and their own playhead
+  const AnimationClip &getAnimationClip(AnimationType type) const;
+  const AnimationStateMachine &getPlayerStateMachine(bool isPrimaryPlayer) const;
 
   FontManager &getFontManager() { return fontManager; }
+  const SDFFontAtlas *getFontAtlas() { return fontManager.getAtlas(renderer); }
+  const AssetArchive &getAssetArchive() const { return archive; }
 
   ResourceManager(const ResourceManager &) = delete;
   ResourceManager &operator=(const ResourceManager &) = delete;
@@ -49,11 +102,54 @@ class ResourceManager {
   ResourceManager() = default;
   ~ResourceManager() = default;
 
-  shared_texture loadTexture(const std::string &filePath);
+  struct DecodedImage {
+    std::weak_ptr<TextureResource> resource;
+    std::string path;
+    SDL_Surface *surface;
+
+    // Replaces the texture of a resource that is already loaded
+    bool reload = false;
+
+    // Set when the surface came from a cooked blob
+    bool cooked = false;
+    std::vector<SDL_FRect> frameBounds;
+    SDL_FRect hitbox{};
+
+    double decodeMs = 0.0;
+  };
+
+  static std::string cookedPathFor(const std::string &path);
+
+  void requestDecode(const std::shared_ptr<TextureResource> &resource, bool reload = false);
+  void queueChangedTextures();
+  SDL_Surface *decodeCooked(const AssetView &blob, DecodedImage &decoded) const;
+  void uploadTexture(TextureResource &resource, const DecodedImage &decoded);
+  void buildPlayerStateMachine(AnimationStateMachine &machine, AnimationType idle, AnimationType run,
+                               AnimationType takingPunch, AssetId idleTexture, AssetId runTexture,
+                               AssetId takingPunchTexture);
 
   SDL_Renderer *renderer = nullptr;
-  std::unordered_map<std::string, std::weak_ptr<SDL_Texture>> textureCache;
-  std::unordered_map<AnimationType, Animation> animations;
+
+  // Declared before everything that may still read from the mapping
+  AssetArchive archive;
+
+  TextureResidency residency{GameConfig::TEXTURE_BUDGET_BYTES};
+
+  std::unique_ptr<ThreadPool> decodePool;
+  std::mutex decodedMutex;
+  std::deque<DecodedImage> decodedImages;
+  size_t texturesRequested = 0;
+  size_t texturesCompleted = 0;
+  bool useCookedAssets = true;
+  TextureLoadStats loadStats;
+
+  bool hotReload = false;
+  AssetWatcher assetWatcher;
+  std::mutex changedMutex;
+  std::vector<std::string> changedPaths;
+  std::unordered_map<AnimationType, AnimationClip> animationClips;
+  AnimationStateMachine player1StateMachine;
+  AnimationStateMachine player2StateMachine;
   FontManager fontManager;
   bool initialized = false;
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/AssetId.h"
+#include "utils/SDLDeleter.h"
+
+enum class TextureLoadState : uint8_t {
+  PENDING,
+  READY,
+  FAILED
+};
+
+// Shared between every handle to the same asset. Only touched on the render thread,
+// decode workers never see it directly.
+struct TextureResource {
+  AssetId id;
+  std::string path;
+  shared_texture texture;
+  TextureLoadState state = TextureLoadState::PENDING;
+  float width = 0.0f;
+  float height = 0.0f;
+  size_t bytes = 0;
+
+  // Precomputed by the asset cooker, empty for textures loaded from PNG
+  std::vector<SDL_FRect> frameBounds;
+  SDL_FRect hitbox{};
+  bool hasHitbox = false;
+};
+
+class TextureHandle {
+ public:
+  TextureHandle() = default;
+  explicit TextureHandle(std::shared_ptr<TextureResource> resource) : resource(std::move(resource)) {}
+
+  // nullptr until the upload has completed
+  SDL_Texture *get() const {
+    return resource && resource->state == TextureLoadState::READY ? resource->texture.get() : nullptr;
+  }
+
+  bool isReady() const { return get() != nullptr; }
+  bool isPending() const { return resource && resource->state == TextureLoadState::PENDING; }
+  explicit operator bool() const { return isReady(); }
+
+  float getWidth() const { return isReady() ? resource->width : 0.0f; }
+  float getHeight() const { return isReady() ? resource->height : 0.0f; }
+
+  // Opaque bounds of the whole animation relative to a frame, nullptr when not cooked
+  const SDL_FRect *getHitbox() const { return isReady() && resource->hasHitbox ? &resource->hitbox : nullptr; }
+
+  // Opaque bounds of one frame relative to the frame, nullptr when not cooked
+  const SDL_FRect *getFrameBounds(int frame) const {
+    if (!isReady() || frame < 0 || static_cast<size_t>(frame) >= resource->frameBounds.size())
+      return nullptr;
+    return &resource->frameBounds[frame];
+  }
+
+  const std::shared_ptr<TextureResource> &getResource() const { return resource; }
+
+ private:
+  std::shared_ptr<TextureResource> resource;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+
+#include "managers/TextureHandle.h"
+#include "utils/AssetIdMap.h"
+
+// Keeps textures resident after their last handle is dropped, up to a byte budget.
+// Textures nobody holds are evicted least recently used first; textures still held
+// outside count towards the budget but are never evicted.
+class TextureResidency {
+ public:
+  explicit TextureResidency(size_t budgetBytes);
+
+  // Marks the texture as most recently used, nullptr on a miss or a texture that failed to load
+  std::shared_ptr<TextureResource> acquire(AssetId id);
+  void insert(const std::shared_ptr<TextureResource> &resource);
+
+  // Lookup without touching the LRU order or the hit rate
+  std::shared_ptr<TextureResource> find(AssetId id) const;
+
+  void enforceBudget();
+  void clear();
+
+  void setBudget(size_t bytes) { budgetBytes = bytes; }
+  size_t getBudget() const { return budgetBytes; }
+
+  size_t getResidentBytes() const { return residentBytes; }
+  size_t getResidentCount() const { return entries.size(); }
+  size_t getEvictionCount() const { return evictions; }
+  float getHitRate() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<TextureResource> resource;
+    std::list<AssetId>::iterator lruPosition;
+  };
+
+  // Front is the most recently used
+  std::list<AssetId> lruOrder;
+  AssetIdMap<Entry> entries;
+
+  size_t budgetBytes;
+  size_t residentBytes = 0;
+
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/Profiler.h"
+
+// Streams profiler samples to a Chrome trace-event JSON file (chrome://tracing, ui.perfetto.dev).
+// The main thread only appends to a buffer, formatting and file writes happen on a background thread.
+class TraceWriter {
+ public:
+  TraceWriter() = default;
+  ~TraceWriter();
+
+  TraceWriter(const TraceWriter &) = delete;
+  TraceWriter &operator=(const TraceWriter &) = delete;
+
+  bool open(const std::string &path);
+
+  // Writes everything still buffered and terminates the JSON array
+  void close();
+
+  bool isOpen() const { return writerThread.joinable(); }
+
+  void submit(const std::vector<Profiler::Sample> &samples);
+
+ private:
+  void writerLoop();
+  void writeEvents(const std::vector<Profiler::Sample> &samples);
+
+  std::ofstream file;
+  std::thread writerThread;
+  Uint64 originCounter = 0;
+  bool firstEvent = true;
+  std::vector<bool> namedThreads;
+
+  std::mutex pendingMutex;
+  std::condition_variable pendingCondition;
+  std::vector<Profiler::Sample> pendingSamples;
+  bool stopping = false;
+};
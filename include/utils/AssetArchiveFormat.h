@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+// On-disk layout of resources.pak, shared by the AssetPacker tool and AssetArchive.
+//
+//   ArchiveHeader
+//   ArchiveEntry[entryCount]
+//   path strings, not null terminated
+//   asset data, each blob aligned to DATA_ALIGNMENT
+//
+// Everything is little endian and addressed by absolute offsets, so a mapped archive
+// can be read in place without parsing into intermediate buffers.
+namespace AssetArchiveFormat {
+
+constexpr char MAGIC[4] = {'B', 'H', 'P', 'K'};
+constexpr uint32_t VERSION = 1;
+constexpr uint64_t DATA_ALIGNMENT = 16;
+
+struct ArchiveHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t reserved;
+};
+
+struct ArchiveEntry {
+  uint64_t dataOffset;
+  uint64_t dataSize;
+  uint32_t pathOffset;
+  uint32_t pathLength;
+};
+
+static_assert(sizeof(ArchiveHeader) == 16, "ArchiveHeader must stay tightly packed");
+static_assert(sizeof(ArchiveEntry) == 24, "ArchiveEntry must stay tightly packed");
+
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace AssetArchiveFormat
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// 64-bit FNV-1a hash of an asset path, computed at compile time for paths from the
+// generated AssetManifest.h. The path is kept alongside for loading and messages.
+class AssetId {
+ public:
+  constexpr AssetId() = default;
+  constexpr explicit AssetId(std::string_view path) : hash(hashPath(path)), path(path) {}
+
+  static constexpr uint64_t hashPath(std::string_view path) {
+    uint64_t value = 0xcbf29ce484222325ull;
+    for (char c : path) {
+      value ^= static_cast<uint8_t>(c);
+      value *= 0x100000001b3ull;
+    }
+    // 0 marks empty slots in AssetIdMap
+    return value != 0 ? value : 1;
+  }
+
+  constexpr uint64_t getHash() const { return hash; }
+  constexpr std::string_view getPath() const { return path; }
+  constexpr bool isValid() const { return hash != 0; }
+
+  constexpr bool operator==(const AssetId &other) const { return hash == other.hash; }
+
+ private:
+  uint64_t hash = 0;
+  std::string_view path;
+};
+
+template <size_t N>
+constexpr bool hasUniqueHashes(const AssetId (&ids)[N]) {
+  for (size_t i = 0; i < N; ++i) {
+    for (size_t j = i + 1; j < N; ++j) {
+      if (ids[i] == ids[j])
+        return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "utils/AssetId.h"
+
+// Flat open-addressing hash map keyed by AssetId hashes, with linear probing and
+// backward-shift deletion. Slots live in one array, a lookup touches a single cache line
+// in the common case. The key hash is used directly as it is already well mixed.
+template <typename T>
+class AssetIdMap {
+ public:
+  AssetIdMap() { slots.resize(INITIAL_CAPACITY); }
+
+  T *find(AssetId id) {
+    size_t index = findIndex(id.getHash());
+    return index != NOT_FOUND ? &slots[index].value : nullptr;
+  }
+
+  const T *find(AssetId id) const {
+    size_t index = findIndex(id.getHash());
+    return index != NOT_FOUND ? &slots[index].value : nullptr;
+  }
+
+  // Inserts or overwrites
+  T &insert(AssetId id, T value) {
+    if ((count + 1) * 4 > slots.size() * 3) {
+      rehash(slots.size() * 2);
+    }
+
+    size_t mask = slots.size() - 1;
+    for (size_t index = id.getHash() & mask;; index = (index + 1) & mask) {
+      Slot &slot = slots[index];
+      if (slot.key == id.getHash()) {
+        slot.value = std::move(value);
+        return slot.value;
+      }
+      if (slot.key == 0) {
+        slot.key = id.getHash();
+        slot.value = std::move(value);
+        count++;
+        return slot.value;
+      }
+    }
+  }
+
+  bool erase(AssetId id) {
+    size_t index = findIndex(id.getHash());
+    if (index == NOT_FOUND)
+      return false;
+
+    // Shift following entries of the probe run back so lookups never need tombstones
+    size_t mask = slots.size() - 1;
+    size_t hole = index;
+    for (size_t next = (hole + 1) & mask; slots[next].key != 0; next = (next + 1) & mask) {
+      size_t home = slots[next].key & mask;
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        slots[hole] = std::move(slots[next]);
+        hole = next;
+      }
+    }
+
+    slots[hole] = Slot{};
+    count--;
+    return true;
+  }
+
+  void clear() {
+    slots.assign(INITIAL_CAPACITY, Slot{});
+    count = 0;
+  }
+
+  size_t size() const { return count; }
+
+  template <typename Function>
+  void forEach(Function &&function) const {
+    for (const Slot &slot : slots) {
+      if (slot.key != 0)
+        function(slot.value);
+    }
+  }
+
+ private:
+  struct Slot {
+    uint64_t key = 0;
+    T value{};
+  };
+
+  static constexpr size_t INITIAL_CAPACITY = 16;
+  static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+  size_t findIndex(uint64_t key) const {
+    size_t mask = slots.size() - 1;
+    for (size_t index = key & mask;; index = (index + 1) & mask) {
+      if (slots[index].key == key)
+        return index;
+      if (slots[index].key == 0)
+        return NOT_FOUND;
+    }
+  }
+
+  void rehash(size_t capacity) {
+    std::vector<Slot> old = std::move(slots);
+    slots.assign(capacity, Slot{});
+    count = 0;
+    for (Slot &slot : old) {
+      if (slot.key != 0) {
+        size_t mask = capacity - 1;
+        size_t index = slot.key & mask;
+        while (slots[index].key != 0) {
+          index = (index + 1) & mask;
+        }
+        slots[index] = std::move(slot);
+        count++;
+      }
+    }
+  }
+
+  std::vector<Slot> slots;
+  size_t count = 0;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+// Layout of a cooked texture (.tex) written by the AssetCooker tool.
+//
+//   CookedTextureHeader
+//   CookedFrame[frameCount]
+//   LZ4 block with width * height * 4 bytes of pixels in pixelFormat, rows tightly packed
+//
+// The pixels are already in the renderer's format, so loading is a decompress and an upload.
+namespace CookedTextureFormat {
+
+constexpr char MAGIC[4] = {'B', 'H', 'T', 'X'};
+constexpr uint32_t VERSION = 1;
+constexpr const char *EXTENSION = ".tex";
+
+struct CookedTextureHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t pixelFormat;  // SDL_PixelFormat
+  uint32_t width;
+  uint32_t height;
+  uint32_t frameCount;
+  uint32_t compressedSize;
+  uint32_t reserved;
+
+  // Union of the opaque frame bounds, relative to the frame origin
+  float hitboxX, hitboxY, hitboxW, hitboxH;
+};
+
+// Opaque bounds of one frame of the horizontal strip, relative to the frame origin
+struct CookedFrame {
+  float x, y, w, h;
+};
+
+static_assert(sizeof(CookedTextureHeader) == 48, "CookedTextureHeader must stay tightly packed");
+static_assert(sizeof(CookedFrame) == 16, "CookedFrame must stay tightly packed");
+
+}  // namespace CookedTextureFormat
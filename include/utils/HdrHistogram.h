@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+// Fixed size log-linear histogram in the style of HdrHistogram. Values up to MAX_VALUE are kept with
+// 2^SUB_BUCKET_BITS sub-buckets per power of two, a relative error below 1.6%. Recording never allocates.
+class HdrHistogram {
+ public:
+  static constexpr uint64_t MAX_VALUE = (uint64_t{1} << 26) - 1;  // about 67 seconds in microseconds
+
+  void record(uint64_t value) {
+    value = std::min(value, MAX_VALUE);
+    counts[bucketIndex(value)]++;
+    totalCount++;
+    maxValue = std::max(maxValue, value);
+  }
+
+  // Highest value equivalent to the one at the percentile, 0 while empty
+  uint64_t getValueAtPercentile(double percentile) const {
+    if (totalCount == 0)
+      return 0;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * totalCount));
+    target = std::clamp<uint64_t>(target, 1, totalCount);
+
+    uint64_t cumulative = 0;
+    for (size_t index = 0; index < BUCKET_COUNT; ++index) {
+      cumulative += counts[index];
+      if (cumulative >= target)
+        return std::min(highestEquivalentValue(index), maxValue);
+    }
+
+    return maxValue;
+  }
+
+  uint64_t getMaxValue() const { return maxValue; }
+  uint64_t getTotalCount() const { return totalCount; }
+
+  void reset() {
+    counts.fill(0);
+    totalCount = 0;
+    maxValue = 0;
+  }
+
+ private:
+  static constexpr int SUB_BUCKET_BITS = 7;
+  static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+  static constexpr uint64_t HALF_SUB_BUCKET_COUNT = SUB_BUCKET_COUNT / 2;
+  static constexpr int MAX_SHIFT = std::bit_width(MAX_VALUE) - SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT + MAX_SHIFT * HALF_SUB_BUCKET_COUNT;
+
+  // Values below SUB_BUCKET_COUNT are exact, above that each power of two gets the upper half of the sub-buckets
+  static size_t bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT)
+      return static_cast<size_t>(value);
+
+    int shift = std::bit_width(value) - SUB_BUCKET_BITS;
+    uint64_t subBucket = value >> shift;
+    return static_cast<size_t>(SUB_BUCKET_COUNT + (shift - 1) * HALF_SUB_BUCKET_COUNT + (subBucket - HALF_SUB_BUCKET_COUNT));
+  }
+
+  static uint64_t highestEquivalentValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT)
+      return index;
+
+    size_t offset = index - SUB_BUCKET_COUNT;
+    int shift = static_cast<int>(offset / HALF_SUB_BUCKET_COUNT) + 1;
+    uint64_t subBucket = offset % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+    return ((subBucket + 1) << shift) - 1;
+  }
+
+  std::array<uint64_t, BUCKET_COUNT> counts{};
+  uint64_t totalCount = 0;
+  uint64_t maxValue = 0;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Layout of the shared memory segment the game publishes its live state into, shared by
+// LiveStatePublisher and the LiveStateInspector tool.
+//
+//   SegmentHeader
+//   Snapshot
+//
+// The snapshot is guarded by a seqlock: the sequence is odd while the game is writing, a reader copies
+// the snapshot and keeps it only if the sequence was even and unchanged around the copy. The game never
+// waits for readers.
+namespace LiveStateFormat {
+
+constexpr char MAGIC[4] = {'B', 'H', 'L', 'S'};
+constexpr uint32_t VERSION = 1;
+
+// shm_open() name without the leading slash, the name of the file mapping on Windows
+constexpr const char *DEFAULT_SEGMENT_NAME = "bloodhorizon_live";
+
+constexpr uint32_t MAX_PLAYERS = 2;
+constexpr uint32_t MAX_COLLISIONS = 8;
+
+struct PlayerState {
+  float positionX;
+  float positionY;
+  float velocityX;
+  float velocityY;
+  float direction;
+  uint32_t animState;  // PlayerAnimState
+  uint32_t animFrame;
+  uint32_t lastSpecial;  // SpecialMove
+  uint8_t grounded;
+  uint8_t reserved[3];
+};
+
+struct CollisionState {
+  uint32_t type;  // CollisionType
+  float contactX;
+  float contactY;
+  float normalX;
+  float normalY;
+  float penetration;
+};
+
+struct Snapshot {
+  uint64_t tick;
+  uint64_t timeNs;  // SDL_GetTicksNS() when published
+  uint32_t gameState;
+  uint32_t playerCount;
+  uint32_t collisionCount;  // of the last collision pass, only the first MAX_COLLISIONS are stored
+  float frameMs;
+  float updateMs;
+  float renderMs;
+  PlayerState players[MAX_PLAYERS];
+  CollisionState collisions[MAX_COLLISIONS];
+};
+
+struct SegmentHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t snapshotSize;
+  uint32_t reserved;
+  std::atomic<uint64_t> sequence;
+};
+
+struct Segment {
+  SegmentHeader header;
+  Snapshot snapshot;
+};
+
+static_assert(std::is_trivially_copyable_v<Snapshot>, "Snapshot is copied with memcpy");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The sequence must be lock free to work across processes");
+static_assert(sizeof(PlayerState) == 36, "PlayerState must stay tightly packed");
+static_assert(sizeof(CollisionState) == 24, "CollisionState must stay tightly packed");
+
+// Single writer
+inline void writeSnapshot(Segment &segment, const Snapshot &snapshot) {
+  uint64_t sequence = segment.header.sequence.load(std::memory_order_relaxed);
+  segment.header.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  std::memcpy(&segment.snapshot, &snapshot, sizeof(Snapshot));
+
+  segment.header.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// Returns false if the game was writing during the copy, the caller retries
+inline bool tryReadSnapshot(const Segment &segment, Snapshot &snapshot) {
+  uint64_t before = segment.header.sequence.load(std::memory_order_acquire);
+  if (before & 1)
+    return false;
+
+  std::memcpy(&snapshot, &segment.snapshot, sizeof(Snapshot));
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  return segment.header.sequence.load(std::memory_order_relaxed) == before;
+}
+
+inline bool isCompatible(const SegmentHeader &header) {
+  return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+         header.snapshotSize == sizeof(Snapshot);
+}
+
+}  // namespace LiveStateFormat
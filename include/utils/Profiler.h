@@ -0,0 +1,239 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AllocationTracker.h"
+
+// Scoped timing zones. Each thread writes into its own single producer ring, the main thread drains
+// all rings once per frame and keeps a few seconds of per-zone totals for the debug overlay.
+// Zone names must be string literals, they are stored by pointer.
+class Profiler {
+ public:
+  static constexpr size_t HISTORY_FRAMES = 180;  // 3 seconds at 60 fps
+  static constexpr size_t RING_CAPACITY = 4096;
+
+  struct Sample {
+    const char *zone;
+    Uint64 startCounter;
+    Uint64 endCounter;
+    uint32_t threadIndex;  // in the order threads first recorded
+    uint32_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+  };
+
+  // Receives every sample drained in a frame, including the frame itself, on the main thread
+  using SampleSink = std::function<void(const std::vector<Sample> &samples)>;
+
+  struct ZoneStats {
+    double lastMs = 0.0;
+    double minMs = 0.0;
+    double avgMs = 0.0;
+    double maxMs = 0.0;
+  };
+
+  struct ZoneHistory {
+    const char *name;
+    std::array<float, HISTORY_FRAMES> frameMs{};
+    double pendingMs = 0.0;  // summed over the samples of the current frame
+
+    AllocationCounters pendingAllocations;
+    AllocationCounters lastFrameAllocations;
+  };
+
+  static Profiler &getInstance() {
+    static Profiler instance;
+    return instance;
+  }
+
+  // Safe from any thread, never blocks. Samples are dropped while the ring of the thread is full.
+  void record(const char *zone, Uint64 startCounter, Uint64 endCounter, const AllocationCounters &allocations = {}) {
+    ThreadRing &ring = threadRing();
+
+    size_t write = ring.writeIndex.load(std::memory_order_relaxed);
+    if (write - ring.readIndex.load(std::memory_order_acquire) == RING_CAPACITY) {
+      droppedSamples.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    ring.samples[write & (RING_CAPACITY - 1)] = Sample{zone, startCounter, endCounter, ring.threadIndex,
+                                                       static_cast<uint32_t>(allocations.count), allocations.bytes};
+    ring.writeIndex.store(write + 1, std::memory_order_release);
+  }
+
+  // Main thread, once per presented frame
+  void endFrame() {
+    frameSamples.clear();
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastFrameCounter != 0) {
+      findZone(FRAME_ZONE).pendingMs += toMs(now - lastFrameCounter);
+      if (sampleSink)
+        frameSamples.push_back(Sample{FRAME_ZONE, lastFrameCounter, now, threadRing().threadIndex});
+    }
+    lastFrameCounter = now;
+
+    {
+      std::lock_guard<std::mutex> lock(ringsMutex);
+      for (const auto &ring : rings) {
+        size_t write = ring->writeIndex.load(std::memory_order_acquire);
+        size_t read = ring->readIndex.load(std::memory_order_relaxed);
+
+        for (; read != write; ++read) {
+          const Sample &sample = ring->samples[read & (RING_CAPACITY - 1)];
+          ZoneHistory &zone = findZone(sample.zone);
+          zone.pendingMs += toMs(sample.endCounter - sample.startCounter);
+          zone.pendingAllocations.count += sample.allocations;
+          zone.pendingAllocations.bytes += sample.allocatedBytes;
+          if (sampleSink)
+            frameSamples.push_back(sample);
+        }
+
+        ring->readIndex.store(write, std::memory_order_release);
+      }
+    }
+
+    historyHead = (historyHead + 1) % HISTORY_FRAMES;
+    historyFrames = std::min(historyFrames + 1, HISTORY_FRAMES);
+
+    for (ZoneHistory &zone : zones) {
+      zone.frameMs[historyHead] = static_cast<float>(zone.pendingMs);
+      zone.pendingMs = 0.0;
+      zone.lastFrameAllocations = zone.pendingAllocations;
+      zone.pendingAllocations = AllocationCounters{};
+    }
+
+    if (sampleSink && !frameSamples.empty())
+      sampleSink(frameSamples);
+  }
+
+  // Call from the main thread before any other thread records, so it gets thread index 0
+  void registerCurrentThread() { threadRing(); }
+
+  // Main thread only, an empty sink stops forwarding
+  void setSampleSink(SampleSink sink) { sampleSink = std::move(sink); }
+
+  ZoneStats getStats(const ZoneHistory &zone) const {
+    ZoneStats stats;
+    if (historyFrames == 0)
+      return stats;
+
+    stats.lastMs = zone.frameMs[historyHead];
+    stats.minMs = zone.frameMs[historyHead];
+    double totalMs = 0.0;
+
+    for (size_t age = 0; age < historyFrames; ++age) {
+      double frameMs = zone.frameMs[(historyHead + HISTORY_FRAMES - age) % HISTORY_FRAMES];
+      stats.minMs = std::min(stats.minMs, frameMs);
+      stats.maxMs = std::max(stats.maxMs, frameMs);
+      totalMs += frameMs;
+    }
+
+    stats.avgMs = totalMs / historyFrames;
+    return stats;
+  }
+
+  // Oldest first, 0 is HISTORY_FRAMES - 1 frames ago
+  float getFrameMs(const ZoneHistory &zone, size_t frame) const {
+    return zone.frameMs[(historyHead + 1 + frame) % HISTORY_FRAMES];
+  }
+
+  const std::vector<ZoneHistory> &getZones() const { return zones; }
+  size_t getDroppedSamples() const { return droppedSamples.load(std::memory_order_relaxed); }
+
+  static constexpr const char *FRAME_ZONE = "Frame";
+
+  static double toMs(Uint64 counter) {
+    return static_cast<double>(counter) * 1000.0 / SDL_GetPerformanceFrequency();
+  }
+
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
+
+ private:
+  Profiler() = default;
+
+  struct ThreadRing {
+    std::array<Sample, RING_CAPACITY> samples;
+    std::atomic<size_t> writeIndex{0};
+    std::atomic<size_t> readIndex{0};
+    uint32_t threadIndex = 0;
+  };
+
+  static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0, "RING_CAPACITY must be a power of two");
+
+  // Rings are owned by the profiler so samples of a thread that already exited can still be drained
+  ThreadRing &threadRing() {
+    thread_local ThreadRing *ring = nullptr;
+    if (!ring) {
+      std::lock_guard<std::mutex> lock(ringsMutex);
+      rings.push_back(std::make_unique<ThreadRing>());
+      ring = rings.back().get();
+      ring->threadIndex = static_cast<uint32_t>(rings.size() - 1);
+    }
+    return *ring;
+  }
+
+  ZoneHistory &findZone(const char *name) {
+    for (ZoneHistory &zone : zones) {
+      if (zone.name == name || std::strcmp(zone.name, name) == 0)
+        return zone;
+    }
+
+    zones.push_back(ZoneHistory{name});
+    return zones.back();
+  }
+
+  std::mutex ringsMutex;
+  std::vector<std::unique_ptr<ThreadRing>> rings;
+  std::atomic<size_t> droppedSamples{0};
+
+  std::vector<ZoneHistory> zones;
+  size_t historyHead = 0;
+  size_t historyFrames = 0;
+  Uint64 lastFrameCounter = 0;
+
+  SampleSink sampleSink;
+  std::vector<Sample> frameSamples;
+};
+
+class ProfileScope {
+ public:
+  explicit ProfileScope(const char *zone)
+      : zone(zone), startAllocations(AllocationTracker::getThreadCounters()), startCounter(SDL_GetPerformanceCounter()) {}
+
+  ~ProfileScope() {
+    Uint64 endCounter = SDL_GetPerformanceCounter();
+    AllocationCounters allocations = AllocationTracker::getThreadCounters();
+    allocations.count -= startAllocations.count;
+    allocations.bytes -= startAllocations.bytes;
+    Profiler::getInstance().record(zone, startCounter, endCounter, allocations);
+  }
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+ private:
+  const char *zone;
+  AllocationCounters startAllocations;
+  Uint64 startCounter;
+};
+
+// Defined by the build for everything but Release
+#ifdef BLOODHORIZON_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME_END() Profiler::getInstance().endFrame()
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
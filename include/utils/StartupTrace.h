@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Records named phases from construction onwards and prints how long each took.
+// Marks are cheap enough to leave in place, nothing is printed unless enabled.
+class StartupTrace {
+ public:
+  StartupTrace() : startCounter(SDL_GetPerformanceCounter()), lastCounter(startCounter) {}
+
+  void setEnabled(bool enabled) { this->enabled = enabled; }
+  bool isEnabled() const { return enabled; }
+
+  // Ends the current phase under this name
+  void mark(const std::string &phase) {
+    if (!enabled || finished)
+      return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    phases.push_back({phase, toMs(now - lastCounter), toMs(now - startCounter)});
+    lastCounter = now;
+  }
+
+  // Prints the breakdown once, later marks are ignored
+  void finish() {
+    if (!enabled || finished)
+      return;
+    finished = true;
+
+    std::cout << "Startup trace:" << '\n';
+    for (const auto &phase : phases) {
+      std::cout << "  " << std::left << std::setw(28) << phase.name << std::right << std::fixed << std::setprecision(2)
+                << std::setw(9) << phase.durationMs << " ms" << std::setw(11) << phase.elapsedMs << " ms total" << '\n';
+    }
+  }
+
+ private:
+  struct Phase {
+    std::string name;
+    double durationMs;
+    double elapsedMs;
+  };
+
+  static double toMs(Uint64 counter) {
+    return static_cast<double>(counter) * 1000.0 / SDL_GetPerformanceFrequency();
+  }
+
+  Uint64 startCounter;
+  Uint64 lastCounter;
+  std::vector<Phase> phases;
+  bool enabled = false;
+  bool finished = false;
+};
@@ -2,25 +2,41 @@
 
 #include <SDL3/SDL.h>
 
+#include <array>
 #include <memory>
 
+#include "Camera.h"
+#include "InputHistory.h"
+#include "MotionRecognizer.h"
+#include "ParallaxBackground.h"
 #include "Player.h"
 #include "managers/InputManager.h"
 #include "managers/ResourceManager.h"
 
 class GameLoop {
  public:
-  GameLoop();
+  GameLoop(SDL_Renderer *renderer);
   ~GameLoop();
 
-  bool update(InputManager inputManager, float deltaTime);
+  bool update(const InputManager &inputManager, float deltaTime);
   void handleInput(const InputManager &inputManager);
-  void render(SDL_Renderer *renderer);
+  void render();
 
   const Player *getPlayer1() const { return player1.get(); }
   const Player *getPlayer2() const { return player2.get(); }
+  const Camera &getCamera() const { return camera; }
 
  private:
   std::unique_ptr<Player> player1 = nullptr;
   std::unique_ptr<Player> player2 = nullptr;
+
+  // Indexed by PlayerId
+  std::array<InputHistory, static_cast<size_t>(PlayerId::COUNT)> inputHistories;
+  std::array<MotionRecognizer::Tracker, static_cast<size_t>(PlayerId::COUNT)> motionTrackers;
+  MotionRecognizer motionRecognizer = MotionRecognizer::createMoveList();
+
+  void handleMotions(const InputManager &inputManager);
+
+  Camera camera;
+  std::unique_ptr<ParallaxBackground> background = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+class LoadingScreen {
+ public:
+  LoadingScreen();
+  ~LoadingScreen();
+
+  void update(float deltaTime);
+  void render();
+
+  // True once every requested texture has been uploaded and the bar has caught up
+  bool isFinished() const;
+
+ private:
+  float displayedProgress = 0.0f;
+};
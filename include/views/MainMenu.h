@@ -4,8 +4,10 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
 
+#include "ParallaxBackground.h"
 #include "managers/InputManager.h"
 #include "managers/ResourceManager.h"
 
@@ -31,10 +33,10 @@ struct MainMenuButton {
 
 class MainMenu {
  public:
-  MainMenu();
+  MainMenu(SDL_Renderer *renderer);
   ~MainMenu();
 
-  void update(const InputManager &inputManager, SDL_Renderer *renderer);
+  void update(const InputManager &inputManager, SDL_Renderer *renderer, float deltaTime);
   void render(SDL_Renderer *renderer);
 
   void startButtonCallback();
@@ -49,5 +51,5 @@ class MainMenu {
 
   MainMenuAction actionToken = MainMenuAction::NONE;
 
-  SDL_Texture *renderText(SDL_Renderer *renderer, const std::string &text, SDL_Color color, int fontSize);
+  std::unique_ptr<ParallaxBackground> background = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Camera.h"
+#include "ParallaxBackground.h"
+#include "Player.h"
+#include "managers/CollisionManager.h"
+#include "utils/HdrHistogram.h"
+
+// Fills the stage with AI fighters, doubling their number every stage up to the requested count,
+// and reports how update, collision and render time grow with it
+class StressTest {
+ public:
+  StressTest(SDL_Renderer *renderer, size_t targetFighterCount);
+  ~StressTest();
+
+  void update(float deltaTime);
+  void render();
+
+  // Game measures the whole render including the queue flush, which the view cannot see
+  void recordRenderTime(double renderMs);
+
+  size_t getFighterCount() const { return fighters.size(); }
+  size_t getTargetFighterCount() const { return targetFighterCount; }
+  bool isFinished() const { return finished; }
+
+  static constexpr size_t FIRST_STAGE_COUNT = 16;
+  static constexpr int WARMUP_FRAMES = 30;
+  static constexpr int MEASURED_FRAMES = 180;
+  static constexpr const char *REPORT_FILE = "stress_report.csv";
+
+ private:
+  // Wraps a fighter so it takes part in CollisionManager::checkAllCollisions
+  class FighterCollider : public ICollidable {
+   public:
+    explicit FighterCollider(const Player *player) : player(player) {}
+
+    SDL_FRect getCollisionBox() const override { return player->getWorldHitbox(); }
+    SDL_FRect getAttackBox() const override { return player->getAttackBox(); }
+    CollisionLayer getCollisionLayer() const override { return CollisionLayer::PLAYER; }
+    bool isCollisionEnabled() const override { return true; }
+    void onCollision(const CollisionInfo &info) override { collisionCount++; }
+    glm::vec2 getPosition() const override { return player->getPosition(); }
+    glm::vec2 getVelocity() const override { return glm::vec2(0.0f); }
+
+   private:
+    const Player *player;
+    size_t collisionCount = 0;
+  };
+
+  enum class Intent : uint8_t {
+    IDLE,
+    WALK_LEFT,
+    WALK_RIGHT,
+    PUNCH,
+    JUMP
+  };
+
+  struct Brain {
+    Intent intent = Intent::IDLE;
+    float timeLeft = 0.0f;
+  };
+
+  struct StageTimings {
+    size_t fighterCount = 0;
+    HdrHistogram updateTimes;
+    HdrHistogram collisionTimes;
+    HdrHistogram renderTimes;
+  };
+
+  void spawnFighters(size_t count);
+  void think(Player &player, Brain &brain, float deltaTime);
+  void finishStage();
+  void writeReport() const;
+
+  size_t targetFighterCount;
+
+  std::vector<std::unique_ptr<Player>> fighters;
+  std::vector<Brain> brains;
+  std::vector<std::shared_ptr<FighterCollider>> colliders;
+  std::mt19937 random{1234};
+
+  Camera camera;
+  std::unique_ptr<ParallaxBackground> background = nullptr;
+
+  std::vector<StageTimings> stages;
+  int stageFrame = 0;
+  // Set by update() for the frame whose render time recordRenderTime() will receive
+  bool measuredFrame = false;
+  bool finished = false;
+};
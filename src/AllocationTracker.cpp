@@ -0,0 +1,152 @@
+#include "AllocationTracker.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local AllocationCounters threadCounters;
+thread_local const char *noAllocRegion = nullptr;
+thread_local bool reportingViolation = false;
+
+constexpr uint64_t MAX_REPORTED_VIOLATIONS = 16;
+
+}  // namespace
+
+AllocationCounters AllocationTracker::getThreadCounters() {
+  return threadCounters;
+}
+
+void AllocationTracker::endFrame() {
+  lastFrame.count = threadCounters.count - frameStart.count;
+  lastFrame.bytes = threadCounters.bytes - frameStart.bytes;
+  frameStart = threadCounters;
+}
+
+void AllocationTracker::onAllocate(size_t size) {
+  threadCounters.count++;
+  threadCounters.bytes += size;
+
+  if (!noAllocRegion || reportingViolation)
+    return;
+
+  // Printing may allocate itself, the guard keeps that from being reported again
+  reportingViolation = true;
+  uint64_t violation = violations.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (violation <= MAX_REPORTED_VIOLATIONS || abortOnViolation) {
+    std::fprintf(stderr, "Allocation of %zu bytes inside no-alloc region '%s'%s\n", size, noAllocRegion,
+                 violation == MAX_REPORTED_VIOLATIONS ? ", further violations are only counted" : "");
+  }
+  reportingViolation = false;
+
+  if (abortOnViolation) {
+    std::abort();
+  }
+}
+
+NoAllocScope::NoAllocScope(const char *region) : previousRegion(noAllocRegion) {
+  noAllocRegion = region;
+}
+
+NoAllocScope::~NoAllocScope() {
+  noAllocRegion = previousRegion;
+}
+
+#ifdef BLOODHORIZON_PROFILE
+
+namespace {
+
+void *allocate(size_t size) {
+  AllocationTracker::onAllocate(size);
+  return std::malloc(size ? size : 1);
+}
+
+void *allocateAligned(size_t size, std::align_val_t alignment) {
+  AllocationTracker::onAllocate(size);
+
+  size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+  return _aligned_malloc(size ? size : 1, align);
+#else
+  // aligned_alloc wants the size to be a multiple of the alignment
+  size_t alignedSize = (size + align - 1) / align * align;
+  return std::aligned_alloc(align, alignedSize ? alignedSize : align);
+#endif
+}
+
+void freeAligned(void *pointer) {
+#ifdef _WIN32
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+}  // namespace
+
+void *operator new(size_t size) {
+  if (void *pointer = allocate(size))
+    return pointer;
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+  if (void *pointer = allocate(size))
+    return pointer;
+  throw std::bad_alloc();
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+  if (void *pointer = allocateAligned(size, alignment))
+    return pointer;
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+  if (void *pointer = allocateAligned(size, alignment))
+    return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  freeAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  freeAligned(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept {
+  freeAligned(pointer);
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept {
+  freeAligned(pointer);
+}
+
+#endif
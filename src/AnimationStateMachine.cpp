@@ -0,0 +1,38 @@
+#include "AnimationStateMachine.h"
+
+AnimationStateMachine::StateId AnimationStateMachine::addState(const std::string &name, const AnimationClip *clip,
+                                                               AssetId texture) {
+  states.push_back({name, clip, texture});
+  return static_cast<StateId>(states.size() - 1);
+}
+
+void AnimationStateMachine::addTransition(StateId from, StateId to, uint8_t required, uint8_t forbidden) {
+  transitions.push_back({from, to, required, forbidden, false});
+}
+
+void AnimationStateMachine::addTransitionFromAny(StateId to, uint8_t required, uint8_t forbidden) {
+  transitions.push_back({0, to, required, forbidden, true});
+}
+
+void AnimationStateMachine::compile() {
+  transitionTable.assign(states.size() * CONDITION_COMBINATIONS, 0);
+
+  for (size_t state = 0; state < states.size(); ++state) {
+    for (size_t conditions = 0; conditions < CONDITION_COMBINATIONS; ++conditions) {
+      StateId target = static_cast<StateId>(state);
+
+      for (const auto &transition : transitions) {
+        bool fromMatches = transition.fromAny ? transition.to != state : transition.from == state;
+        if (!fromMatches)
+          continue;
+
+        if ((conditions & transition.required) == transition.required && (conditions & transition.forbidden) == 0) {
+          target = transition.to;
+          break;
+        }
+      }
+
+      transitionTable[state * CONDITION_COMBINATIONS + conditions] = target;
+    }
+  }
+}
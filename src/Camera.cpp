@@ -0,0 +1,78 @@
+#include "Camera.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "GameConfig.h"
+
+Camera::Camera(const SDL_FRect &stageBounds, float viewportWidth, float viewportHeight)
+    : stageBounds(stageBounds), viewportWidth(viewportWidth), viewportHeight(viewportHeight) {
+  center = glm::vec2(stageBounds.x + stageBounds.w * 0.5f, stageBounds.y + stageBounds.h * 0.5f);
+  clampToStage();
+}
+
+void Camera::setZoomLimits(float minZoom, float maxZoom) {
+  this->minZoom = minZoom;
+  this->maxZoom = std::max(minZoom, maxZoom);
+  zoom = std::clamp(zoom, this->minZoom, this->maxZoom);
+}
+
+void Camera::follow(const glm::vec2 &targetA, const glm::vec2 &targetB, float deltaTime, bool snap) {
+  float distance = std::abs(targetB.x - targetA.x);
+  float targetZoom = std::clamp(viewportWidth / (distance + FRAMING_MARGIN), minZoom, maxZoom);
+  float targetCenterX = (targetA.x + targetB.x) * 0.5f;
+
+  if (snap) {
+    zoom = targetZoom;
+    center.x = targetCenterX;
+  } else {
+    // Frame-rate independent exponential smoothing
+    zoom += (targetZoom - zoom) * (1.0f - std::exp(-ZOOM_RATE * deltaTime));
+    center.x += (targetCenterX - center.x) * (1.0f - std::exp(-FOLLOW_RATE * deltaTime));
+  }
+
+  clampToStage();
+}
+
+void Camera::clampToStage() {
+  float viewWidth = viewportWidth / zoom;
+  float viewHeight = viewportHeight / zoom;
+
+  if (viewWidth >= stageBounds.w) {
+    center.x = stageBounds.x + stageBounds.w * 0.5f;
+  } else {
+    center.x = std::clamp(center.x, stageBounds.x + viewWidth * 0.5f, stageBounds.x + stageBounds.w - viewWidth * 0.5f);
+  }
+
+  // The ground line stays on the same screen row at every zoom level, matching the background layers
+  float groundY = GameConfig::LOGICAL_HEIGHT * GameConfig::PLAYER_Y_RATIO;
+  float groundScreenY = viewportHeight * GameConfig::PLAYER_Y_RATIO;
+  center.y = groundY - groundScreenY / zoom + viewHeight * 0.5f;
+}
+
+SDL_FRect Camera::getViewRect() const {
+  float viewWidth = viewportWidth / zoom;
+  float viewHeight = viewportHeight / zoom;
+  return SDL_FRect{center.x - viewWidth * 0.5f, center.y - viewHeight * 0.5f, viewWidth, viewHeight};
+}
+
+glm::vec2 Camera::worldToScreen(const glm::vec2 &worldPoint) const {
+  SDL_FRect view = getViewRect();
+  return glm::vec2((worldPoint.x - view.x) * zoom, (worldPoint.y - view.y) * zoom);
+}
+
+SDL_FRect Camera::worldToScreen(const SDL_FRect &worldRect) const {
+  SDL_FRect view = getViewRect();
+  return SDL_FRect{(worldRect.x - view.x) * zoom, (worldRect.y - view.y) * zoom, worldRect.w * zoom, worldRect.h * zoom};
+}
+
+glm::vec2 Camera::screenToWorld(const glm::vec2 &screenPoint) const {
+  SDL_FRect view = getViewRect();
+  return glm::vec2(view.x + screenPoint.x / zoom, view.y + screenPoint.y / zoom);
+}
+
+bool Camera::isVisible(const SDL_FRect &worldRect) const {
+  SDL_FRect view = getViewRect();
+  return worldRect.x < view.x + view.w && worldRect.x + worldRect.w > view.x &&
+         worldRect.y < view.y + view.h && worldRect.y + worldRect.h > view.y;
+}
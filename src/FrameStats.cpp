@@ -0,0 +1,78 @@
+#include "FrameStats.h"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+constexpr double REPORT_PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+constexpr const char *REPORT_PERCENTILE_NAMES[] = {"p50", "p90", "p99", "p99.9"};
+
+}  // namespace
+
+void FrameStats::setTargetFrameRate(float targetRateHz) {
+  if (targetRateHz > 0.0f)
+    this->targetRateHz = targetRateHz;
+}
+
+void FrameStats::recordFrame(double frameMs, double updateMs, double renderMs) {
+  frameTimes.record(static_cast<uint64_t>(frameMs * 1000.0));
+  updateTimes.record(static_cast<uint64_t>(updateMs * 1000.0));
+  renderTimes.record(static_cast<uint64_t>(renderMs * 1000.0));
+
+  if (frameMs > MISSED_VSYNC_FACTOR * 1000.0 / targetRateHz)
+    missedVsyncFrames++;
+}
+
+bool FrameStats::writeReport(const std::string &path) const {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    std::cerr << "Failed to write frame report: " << path << '\n';
+    return false;
+  }
+
+  const Metric metrics[] = {{"frame", frameTimes}, {"update", updateTimes}, {"render", renderTimes}};
+
+  if (path.ends_with(".csv")) {
+    file << "metric,samples,p50_ms,p90_ms,p99_ms,p99_9_ms,max_ms,target_hz,missed_vsync\n";
+
+    for (const Metric &metric : metrics) {
+      file << std::format("{},{}", metric.name, metric.histogram.getTotalCount());
+      for (double percentile : REPORT_PERCENTILES) {
+        file << std::format(",{:.3f}", toMs(metric.histogram.getValueAtPercentile(percentile)));
+      }
+      file << std::format(",{:.3f},{:.1f},{}\n", toMs(metric.histogram.getMaxValue()), targetRateHz, missedVsyncFrames);
+    }
+  } else {
+    file << std::format("{{\n  \"targetRateHz\": {:.1f},\n  \"missedVsyncFrames\": {}", targetRateHz, missedVsyncFrames);
+
+    for (const Metric &metric : metrics) {
+      file << std::format(",\n  \"{}\": {{\"samples\": {}", metric.name, metric.histogram.getTotalCount());
+      for (size_t i = 0; i < std::size(REPORT_PERCENTILES); ++i) {
+        file << std::format(", \"{}\": {:.3f}", REPORT_PERCENTILE_NAMES[i],
+                            toMs(metric.histogram.getValueAtPercentile(REPORT_PERCENTILES[i])));
+      }
+      file << std::format(", \"max\": {:.3f}}}", toMs(metric.histogram.getMaxValue()));
+    }
+
+    file << "\n}\n";
+  }
+
+  std::cout << "Frame report written to " << path << '\n';
+  return true;
+}
+
+void FrameStats::printSummary() const {
+  const Metric metrics[] = {{"Frame", frameTimes}, {"Update", updateTimes}, {"Render", renderTimes}};
+
+  for (const Metric &metric : metrics) {
+    const HdrHistogram &histogram = metric.histogram;
+    std::cout << std::format("{:<7} p50 {:.2f}  p90 {:.2f}  p99 {:.2f}  p99.9 {:.2f}  max {:.2f} ms\n", metric.name,
+                             toMs(histogram.getValueAtPercentile(50.0)), toMs(histogram.getValueAtPercentile(90.0)),
+                             toMs(histogram.getValueAtPercentile(99.0)), toMs(histogram.getValueAtPercentile(99.9)),
+                             toMs(histogram.getMaxValue()));
+  }
+  std::cout << std::format("Missed vsync: {} of {} frames at {:.0f} Hz target\n", missedVsyncFrames,
+                           frameTimes.getTotalCount(), targetRateHz);
+}
@@ -1,58 +1,122 @@
 #include "Game.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "AllocationTracker.h"
 #include "GameConfig.h"
+#include "managers/CollisionManager.h"
+#include "managers/DebugDraw.h"
 #include "managers/DebugManager.h"
+#include "managers/RenderBackendManager.h"
+#include "managers/RenderManager.h"
+#include "utils/Profiler.h"
+
+Game::Game(const LaunchOptions &options) : options(options) {
+  startupTrace.setEnabled(options.startupTrace);
+
+  Profiler::getInstance().registerCurrentThread();
+  AllocationTracker::setAbortOnViolation(options.allocAsserts);
+  if (!options.traceFile.empty()) {
+#ifdef BLOODHORIZON_PROFILE
+    if (traceWriter.open(options.traceFile)) {
+      Profiler::getInstance().setSampleSink([this](const std::vector<Profiler::Sample> &samples) {
+        traceWriter.submit(samples);
+      });
+    }
+#else
+    std::cerr << "--trace needs a build with profiling zones, they are compiled out of Release" << '\n';
+#endif
+  }
+
+  if (!options.liveStateName.empty()) {
+    liveState.open(options.liveStateName);
+  }
 
-Game::Game() {
   if (!SDL_Init(SDL_INIT_VIDEO)) {
     SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error initializing SDL", nullptr);
   }
+  startupTrace.mark("SDL_Init");
+
+  // Asset setup needs no renderer. Texture decoding and the font atlas run on the worker
+  // pool while the window and renderer are created below.
+  ResourceManager &resources = ResourceManager::getInstance();
+  resources.setUseCookedAssets(options.useCookedAssets);
+  resources.setHotReload(options.hotReload);
+  if (options.textureBudgetMegabytes > 0) {
+    resources.setTextureBudget(static_cast<size_t>(options.textureBudgetMegabytes) * 1024 * 1024);
+  }
+  if (!resources.initialize()) {
+    SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error initializing ResourceManager", nullptr);
+    cleanup();
+  }
+  startupTrace.mark("Resources (async decode)");
 
   window = unique_window(SDL_CreateWindow("Blood Horizon", GameConfig::DEFAULT_WINDOW_WIDTH, GameConfig::DEFAULT_WINDOW_HEIGHT, 0));
   if (!window) {
     SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error creating window", nullptr);
     cleanup();
   }
+  startupTrace.mark("Window");
 
-  renderer = unique_renderer(SDL_CreateRenderer(window.get(), nullptr));
+  std::string backend = RenderBackendManager::getInstance().selectBackend(window.get(), options);
+  renderer = unique_renderer(SDL_CreateRenderer(window.get(), backend.empty() ? nullptr : backend.c_str()));
+  if (!renderer && !backend.empty()) {
+    std::cerr << "Failed to create '" << backend << "' renderer, using default: " << SDL_GetError() << '\n';
+    renderer = unique_renderer(SDL_CreateRenderer(window.get(), nullptr));
+  }
+  if (renderer) {
+    std::cout << "Using render driver: " << SDL_GetRendererName(renderer.get()) << '\n';
+  }
   if (!renderer) {
     SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error creating renderer", nullptr);
     cleanup();
   }
+  startupTrace.mark("Renderer");
 
   ResolutionManager &resolutionManager = ResolutionManager::getInstance();
   resolutionManager.initialize(GameConfig::LOGICAL_WIDTH, GameConfig::LOGICAL_HEIGHT,
                                GameConfig::DEFAULT_WINDOW_WIDTH, GameConfig::DEFAULT_WINDOW_HEIGHT);
 
-  ResourceManager &resources = ResourceManager::getInstance();
-  if (!resources.initialize(renderer.get())) {
-    SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error initializing ResourceManager", nullptr);
-    cleanup();
-  }
+  resources.attachRenderer(renderer.get());
 
   SDL_SetRenderVSync(renderer.get(), 1);
 
-  SDL_SetRenderLogicalPresentation(renderer.get(), GameConfig::LOGICAL_WIDTH, GameConfig::LOGICAL_HEIGHT,
-                                   SDL_LOGICAL_PRESENTATION_LETTERBOX);
+  sceneTarget = unique_texture(SDL_CreateTexture(renderer.get(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                                 GameConfig::LOGICAL_WIDTH, GameConfig::LOGICAL_HEIGHT));
+  if (sceneTarget) {
+    SDL_SetTextureScaleMode(sceneTarget.get(), SDL_SCALEMODE_NEAREST);
+  } else {
+    std::cerr << "Offscreen render target unavailable, using logical presentation: " << SDL_GetError() << '\n';
+    SDL_SetRenderLogicalPresentation(renderer.get(), GameConfig::LOGICAL_WIDTH, GameConfig::LOGICAL_HEIGHT,
+                                     SDL_LOGICAL_PRESENTATION_LETTERBOX);
+  }
+  ResolutionManager::getInstance().setOffscreenPresentation(sceneTarget != nullptr);
 
+  RenderManager::getInstance().initialize(renderer.get());
   DebugManager::getInstance().initialize(renderer.get());
+  startupTrace.mark("Render target and managers");
 
   switch (currentGameState) {
+    case GameState::LOADING: {
+      loadingScreenView = std::make_unique<LoadingScreen>();
+      break;
+    }
     case GameState::MAINMENU: {
-      mainMenuView = std::make_unique<MainMenu>();
+      mainMenuView = std::make_unique<MainMenu>(renderer.get());
       break;
     }
     case GameState::GAMELOOP: {
-      gameLoopView = std::make_unique<GameLoop>();
+      gameLoopView = std::make_unique<GameLoop>(renderer.get());
       break;
     }
     default: {
-      mainMenuView = std::make_unique<MainMenu>();
+      mainMenuView = std::make_unique<MainMenu>(renderer.get());
       break;
     }
   }
+
+  startupTrace.mark("Initial view");
 }
 
 Game::~Game() {
@@ -62,6 +126,18 @@ Game::~Game() {
 void Game::run() {
   const int TARGET_FPS = 60;
   const double TARGET_FRAME_TIME = 1000.0 / TARGET_FPS;  // milliseconds
+  const double TEXTURE_UPLOAD_BUDGET = 4.0;             // milliseconds
+
+  // Vsync and the frame cap both limit the rate, a frame missed the target when it took 1.5 intervals
+  float displayRefreshRate = TARGET_FPS;
+  if (const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window.get()))) {
+    if (mode->refresh_rate > 0.0f)
+      displayRefreshRate = mode->refresh_rate;
+  }
+  frameStats.setTargetFrameRate(std::min(displayRefreshRate, static_cast<float>(TARGET_FPS)));
+
+  const double counterToMs = 1000.0 / SDL_GetPerformanceFrequency();
+  bool firstFrame = true;
 
   uint64_t lastFrameTime = SDL_GetPerformanceCounter();
 
@@ -85,31 +161,82 @@ void Game::run() {
             ResolutionManager &resolutionManager = ResolutionManager::getInstance();
             resolutionManager.toggleFullscreen(window.get());
             fullscreen = resolutionManager.isFullscreen();
+          } else if (event.key.scancode == SDL_SCANCODE_F9) {
+            writeFrameReport();
           }
           break;
       }
       inputManager.processEvent(event);
     }
 
+    // Textures decoded in the background are turned into GPU textures here, a few per frame
+    ResourceManager::getInstance().processUploads(TEXTURE_UPLOAD_BUDGET);
+
+    uint64_t updateStart = SDL_GetPerformanceCounter();
     update(deltaTimeMs / 1000.0f);  // Convert to seconds for compatibility
+    inputManager.markApplied(++simulationTick);
 
+    uint64_t renderStart = SDL_GetPerformanceCounter();
     render();
+    uint64_t renderEnd = SDL_GetPerformanceCounter();
+
+    presentScene();
+    inputManager.markPresented(SDL_GetTicksNS());
+    PROFILE_FRAME_END();
+    AllocationTracker::endFrame();
+
+    // The first delta only covers the time since the loop was entered
+    if (!firstFrame) {
+      frameStats.recordFrame(deltaTimeMs, (renderStart - updateStart) * counterToMs, (renderEnd - renderStart) * counterToMs);
+    }
+    if (currentGameState == GameState::STRESS && stressTestView) {
+      stressTestView->recordRenderTime((renderEnd - renderStart) * counterToMs);
+    }
+    if (liveState.isOpen()) {
+      publishLiveState(deltaTimeMs, (renderStart - updateStart) * counterToMs, (renderEnd - renderStart) * counterToMs);
+    }
+    firstFrame = false;
+
+    if (startupTrace.isEnabled()) {
+      startupTrace.mark("First frame presented");
+      startupTrace.finish();
+    }
 
     // Frame rate limiting
     double frameTimeMs = (double)(SDL_GetPerformanceCounter() - currentTime) / SDL_GetPerformanceFrequency() * 1000.0;
     if (frameTimeMs < TARGET_FRAME_TIME) {
+      PROFILE_ZONE("Frame cap delay");
       SDL_Delay((Uint32)(TARGET_FRAME_TIME - frameTimeMs));
     }
   }
 
+  Profiler::getInstance().setSampleSink(nullptr);
+  traceWriter.close();
+  liveState.close();
+
+  if (!options.frameReportFile.empty()) {
+    writeFrameReport();
+  }
+
+  RenderManager::getInstance().cleanup();
   ResourceManager::getInstance().cleanup();
   cleanup();
 }
 
 void Game::update(float deltaTime) {
+  PROFILE_ZONE("Game::update");
+
   switch (currentGameState) {
+    case GameState::LOADING: {
+      loadingScreenView->update(deltaTime);
+
+      if (loadingScreenView->isFinished()) {
+        changeGameState(options.stressFighterCount > 0 ? GameState::STRESS : GameState::MAINMENU);
+      }
+      break;
+    }
     case GameState::MAINMENU: {
-      mainMenuView->update(inputManager, renderer.get());
+      mainMenuView->update(inputManager, renderer.get(), deltaTime);
 
       switch (mainMenuView->getMainMenuAction()) {
         case MainMenuAction::QUIT: {
@@ -129,12 +256,20 @@ void Game::update(float deltaTime) {
       gameLoopView->update(inputManager, deltaTime);
       break;
     }
+    case GameState::STRESS: {
+      stressTestView->update(deltaTime);
+      break;
+    }
     default:
       break;
   }
 }
 
 void Game::render() {
+  if (sceneTarget) {
+    SDL_SetRenderTarget(renderer.get(), sceneTarget.get());
+  }
+
   SDL_SetRenderDrawColor(renderer.get(), 20, 10, 30, 255);
   SDL_RenderClear(renderer.get());
 
@@ -143,27 +278,58 @@ void Game::render() {
   if (debugMode) {
     DebugManager::getInstance().clear();
     renderDebug();
-    DebugManager::getInstance().render(renderer.get());
+    DebugManager::getInstance().render();
 
     if (currentGameState == GameState::GAMELOOP && gameLoopView) {
       const Player *player1 = gameLoopView->getPlayer1();
       const Player *player2 = gameLoopView->getPlayer2();
-      DebugManager::getInstance().renderCollisionBoxes(renderer.get(), player1, player2);
+      DebugManager::getInstance().renderCollisionBoxes(player1, player2);
     }
   }
 
-  // swap buffers and present
+  // Debug shapes drawn anywhere this frame go into the queue as one geometry command
+  DebugDraw::getInstance().submit();
+
+  // execute everything submitted this frame in sort key order
+  RenderManager::getInstance().flush();
+}
+
+void Game::presentScene() {
+  if (sceneTarget) {
+    SDL_SetRenderTarget(renderer.get(), nullptr);
+
+    SDL_SetRenderDrawColor(renderer.get(), 0, 0, 0, 255);
+    SDL_RenderClear(renderer.get());
+
+    int outputWidth, outputHeight;
+    SDL_GetRenderOutputSize(renderer.get(), &outputWidth, &outputHeight);
+
+    // Single integer upscale, the remainder stays black
+    SDL_FRect viewport = ResolutionManager::getInstance().getPresentationRect(outputWidth, outputHeight);
+    SDL_RenderTexture(renderer.get(), sceneTarget.get(), nullptr, &viewport);
+  }
+
+  // swap buffers and present, blocks on vsync
+  PROFILE_ZONE("SDL_RenderPresent");
   SDL_RenderPresent(renderer.get());
 }
 
 void Game::renderUI() {
   switch (currentGameState) {
+    case GameState::LOADING: {
+      loadingScreenView->render();
+      break;
+    }
     case GameState::MAINMENU: {
       mainMenuView->render(renderer.get());
       break;
     }
     case GameState::GAMELOOP: {
-      gameLoopView->render(renderer.get());
+      gameLoopView->render();
+      break;
+    }
+    case GameState::STRESS: {
+      stressTestView->render();
       break;
     }
     default:
@@ -183,6 +349,29 @@ void Game::renderDebug() {
 
   debug.debugCollisionManager();
 
+  debug.debugProfiler();
+
+  debug.debugAllocations();
+
+  RenderManager &renderManager = RenderManager::getInstance();
+  debug.addDebugValue("Render commands", static_cast<int>(renderManager.getLastFrameCommandCount()));
+  debug.addDebugValue("Culled commands", static_cast<int>(renderManager.getLastFrameCulledCount()));
+  debug.addDebugValue("State changes", static_cast<int>(renderManager.getLastFrameStateChanges()));
+  debug.addDebugValue("Debug draw vertices", static_cast<int>(DebugDraw::getInstance().getLastFrameVertexCount()));
+
+  const TextureResidency &residency = ResourceManager::getInstance().getResidency();
+  debug.addDebugValue("Resident textures", static_cast<int>(residency.getResidentCount()));
+  debug.addDebugValue("Texture MB", residency.getResidentBytes() / (1024.0f * 1024.0f));
+  debug.addDebugValue("Texture hit rate", residency.getHitRate());
+  debug.addDebugValue("Texture evictions", static_cast<int>(residency.getEvictionCount()));
+  debug.addDebugText("");
+
+  if (currentGameState == GameState::STRESS && stressTestView) {
+    debug.addDebugValue("Stress fighters", static_cast<int>(stressTestView->getFighterCount()));
+    debug.addDebugValue("Stress complete", stressTestView->isFinished());
+    debug.addDebugText("");
+  }
+
   if (currentGameState == GameState::GAMELOOP && gameLoopView) {
     const Player *player1 = gameLoopView->getPlayer1();
     const Player *player2 = gameLoopView->getPlayer2();
@@ -211,6 +400,7 @@ void Game::changeResolution(const Resolution &newResolution) {
 }
 
 void Game::cleanup() {
+  sceneTarget.reset();
   renderer.reset();
   window.reset();
   SDL_Quit();
@@ -224,18 +414,74 @@ void Game::changeGameState(GameState newGameState) {
     case GameState::GAMELOOP: {
       // TODO: unload rest views
 
-      gameLoopView = std::make_unique<GameLoop>();
+      gameLoopView = std::make_unique<GameLoop>(renderer.get());
       currentGameState = GameState::GAMELOOP;
       break;
     }
     case GameState::MAINMENU: {
-      // TODO: unload rest views
+      loadingScreenView.reset();
 
-      mainMenuView = std::make_unique<MainMenu>();
+      mainMenuView = std::make_unique<MainMenu>(renderer.get());
       currentGameState = GameState::MAINMENU;
       break;
     }
+    case GameState::STRESS: {
+      loadingScreenView.reset();
+
+      stressTestView = std::make_unique<StressTest>(renderer.get(), static_cast<size_t>(options.stressFighterCount));
+      currentGameState = GameState::STRESS;
+      break;
+    }
     default:
       break;
   }
+}
+
+void Game::writeFrameReport() {
+  frameStats.printSummary();
+  frameStats.writeReport(options.frameReportFile.empty() ? "frame_report.json" : options.frameReportFile);
+}
+
+void Game::publishLiveState(double frameMs, double updateMs, double renderMs) {
+  LiveStateFormat::Snapshot snapshot{};
+  snapshot.tick = simulationTick;
+  snapshot.timeNs = SDL_GetTicksNS();
+  snapshot.gameState = static_cast<uint32_t>(currentGameState);
+  snapshot.frameMs = static_cast<float>(frameMs);
+  snapshot.updateMs = static_cast<float>(updateMs);
+  snapshot.renderMs = static_cast<float>(renderMs);
+
+  if (currentGameState == GameState::GAMELOOP && gameLoopView) {
+    const Player *players[LiveStateFormat::MAX_PLAYERS] = {gameLoopView->getPlayer1(), gameLoopView->getPlayer2()};
+
+    for (const Player *player : players) {
+      if (!player)
+        continue;
+
+      LiveStateFormat::PlayerState &state = snapshot.players[snapshot.playerCount++];
+      state.positionX = player->getPosition().x;
+      state.positionY = player->getPosition().y;
+      state.velocityX = player->getVelocity().x;
+      state.velocityY = player->getVelocity().y;
+      state.direction = player->getDirection();
+      state.animState = static_cast<uint32_t>(player->getCurrentAnimation());
+      state.animFrame = static_cast<uint32_t>(player->getAnimationFrame());
+      state.lastSpecial = static_cast<uint32_t>(player->getLastSpecial());
+      state.grounded = player->isPlayerGrounded();
+    }
+
+    const auto &collisions = CollisionManager::getInstance().getLastFrameCollisions();
+    snapshot.collisionCount = static_cast<uint32_t>(collisions.size());
+    for (size_t i = 0; i < collisions.size() && i < LiveStateFormat::MAX_COLLISIONS; ++i) {
+      LiveStateFormat::CollisionState &state = snapshot.collisions[i];
+      state.type = static_cast<uint32_t>(collisions[i].type);
+      state.contactX = collisions[i].contactPoint.x;
+      state.contactY = collisions[i].contactPoint.y;
+      state.normalX = collisions[i].normal.x;
+      state.normalY = collisions[i].normal.y;
+      state.penetration = collisions[i].penetration;
+    }
+  }
+
+  liveState.publish(snapshot);
 }
\ No newline at end of file
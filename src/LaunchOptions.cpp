@@ -0,0 +1,47 @@
+#include "LaunchOptions.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+#include "utils/LiveStateFormat.h"
+
+LaunchOptions LaunchOptions::parse(int argc, char *argv[]) {
+  LaunchOptions options;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+
+    if (arg.starts_with("--renderer=")) {
+      options.rendererName = std::string(arg.substr(std::string_view("--renderer=").size()));
+    } else if (arg == "--list-renderers") {
+      options.listRenderers = true;
+    } else if (arg == "--benchmark-renderers") {
+      options.benchmarkRenderers = true;
+    } else if (arg == "--no-cooked-assets") {
+      options.useCookedAssets = false;
+    } else if (arg == "--hot-reload") {
+      options.hotReload = true;
+    } else if (arg == "--startup-trace") {
+      options.startupTrace = true;
+    } else if (arg.starts_with("--trace=")) {
+      options.traceFile = std::string(arg.substr(std::string_view("--trace=").size()));
+    } else if (arg.starts_with("--frame-report=")) {
+      options.frameReportFile = std::string(arg.substr(std::string_view("--frame-report=").size()));
+    } else if (arg.starts_with("--stress=")) {
+      options.stressFighterCount = std::atoi(std::string(arg.substr(std::string_view("--stress=").size())).c_str());
+    } else if (arg == "--live-state") {
+      options.liveStateName = LiveStateFormat::DEFAULT_SEGMENT_NAME;
+    } else if (arg.starts_with("--live-state=")) {
+      options.liveStateName = std::string(arg.substr(std::string_view("--live-state=").size()));
+    } else if (arg == "--alloc-asserts") {
+      options.allocAsserts = true;
+    } else if (arg.starts_with("--texture-budget=")) {
+      options.textureBudgetMegabytes = std::atoi(std::string(arg.substr(std::string_view("--texture-budget=").size())).c_str());
+    } else {
+      std::cerr << "Unknown option: " << arg << '\n';
+    }
+  }
+
+  return options;
+}
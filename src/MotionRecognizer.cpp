@@ -0,0 +1,151 @@
+#include "MotionRecognizer.h"
+
+#include <deque>
+
+const char *getSpecialMoveName(SpecialMove move) {
+  switch (move) {
+    case SpecialMove::LUNGE_PUNCH:
+      return "Lunge punch";
+    case SpecialMove::RETREAT_PUNCH:
+      return "Retreat punch";
+    default:
+      return "None";
+  }
+}
+
+MotionRecognizer MotionRecognizer::createMoveList() {
+  using Symbol = MotionSymbol;
+
+  MotionRecognizer recognizer;
+
+  recognizer.addMotion(SpecialMove::LUNGE_PUNCH, {Symbol::DOWN, Symbol::DOWN_FORWARD, Symbol::FORWARD, Symbol::PUNCH});
+  recognizer.addMotion(SpecialMove::RETREAT_PUNCH, {Symbol::DOWN, Symbol::DOWN_BACK, Symbol::BACK, Symbol::PUNCH});
+
+  // Keyboards make the diagonal easy to skip, accept the motions without it too
+  recognizer.addMotion(SpecialMove::LUNGE_PUNCH, {Symbol::DOWN, Symbol::FORWARD, Symbol::PUNCH});
+  recognizer.addMotion(SpecialMove::RETREAT_PUNCH, {Symbol::DOWN, Symbol::BACK, Symbol::PUNCH});
+
+  recognizer.compile();
+  return recognizer;
+}
+
+void MotionRecognizer::addMotion(SpecialMove move, std::initializer_list<MotionSymbol> sequence) {
+  motions.push_back({move, sequence});
+}
+
+void MotionRecognizer::compile() {
+  // Trie of all motions, -1 marks a missing edge
+  std::vector<std::array<int, SYMBOL_COUNT>> edges(1);
+  edges[0].fill(-1);
+  std::vector<size_t> outputLength(1, 0);
+  outputs.assign(1, SpecialMove::NONE);
+
+  for (const Motion &motion : motions) {
+    size_t node = 0;
+    for (MotionSymbol symbol : motion.sequence) {
+      int child = edges[node][static_cast<size_t>(symbol)];
+      if (child < 0) {
+        child = static_cast<int>(edges.size());
+        edges[node][static_cast<size_t>(symbol)] = child;
+        edges.emplace_back().fill(-1);
+        outputs.push_back(SpecialMove::NONE);
+        outputLength.push_back(0);
+      }
+      node = static_cast<size_t>(child);
+    }
+
+    if (motion.sequence.size() > outputLength[node]) {
+      outputs[node] = motion.move;
+      outputLength[node] = motion.sequence.size();
+    }
+  }
+
+  // Breadth first over the trie, so the failure state of a node is always complete before the node.
+  // Missing edges are redirected to where the failure state goes, which turns the trie into a DFA.
+  transitionTable.assign(edges.size() * SYMBOL_COUNT, 0);
+  std::vector<StateId> failure(edges.size(), 0);
+  std::deque<size_t> queue;
+
+  for (size_t symbol = 0; symbol < SYMBOL_COUNT; ++symbol) {
+    int child = edges[0][symbol];
+    if (child >= 0) {
+      transitionTable[symbol] = static_cast<StateId>(child);
+      queue.push_back(static_cast<size_t>(child));
+    }
+  }
+
+  while (!queue.empty()) {
+    size_t node = queue.front();
+    queue.pop_front();
+
+    // A motion ending inside a longer one still fires, e.g. the short form of a quarter circle
+    if (outputLength[failure[node]] > outputLength[node]) {
+      outputs[node] = outputs[failure[node]];
+      outputLength[node] = outputLength[failure[node]];
+    }
+
+    for (size_t symbol = 0; symbol < SYMBOL_COUNT; ++symbol) {
+      StateId fallback = transitionTable[failure[node] * SYMBOL_COUNT + symbol];
+      int child = edges[node][symbol];
+
+      if (child >= 0) {
+        failure[child] = fallback;
+        transitionTable[node * SYMBOL_COUNT + symbol] = static_cast<StateId>(child);
+        queue.push_back(static_cast<size_t>(child));
+      } else {
+        transitionTable[node * SYMBOL_COUNT + symbol] = fallback;
+      }
+    }
+  }
+}
+
+MotionSymbol MotionRecognizer::directionSymbol(uint8_t actionBits, float facing) {
+  bool left = InputHistory::isSet(actionBits, PlayerAction::MoveLeft);
+  bool right = InputHistory::isSet(actionBits, PlayerAction::MoveRight);
+  bool up = InputHistory::isSet(actionBits, PlayerAction::Jump);
+  bool down = InputHistory::isSet(actionBits, PlayerAction::Crouch);
+
+  // Numpad layout, rows from the bottom, columns back to forward
+  int horizontal = (right ? 1 : 0) - (left ? 1 : 0);
+  if (facing < 0)
+    horizontal = -horizontal;
+  int vertical = (up ? 1 : 0) - (down ? 1 : 0);
+
+  return static_cast<MotionSymbol>((vertical + 1) * 3 + (horizontal + 1));
+}
+
+SpecialMove MotionRecognizer::feed(Tracker &tracker, MotionSymbol symbol) const {
+  tracker.state = transitionTable[tracker.state * SYMBOL_COUNT + static_cast<size_t>(symbol)];
+  tracker.ticksSinceSymbol = 0;
+
+  SpecialMove move = outputs[tracker.state];
+  if (move != SpecialMove::NONE)
+    tracker.state = 0;
+  return move;
+}
+
+SpecialMove MotionRecognizer::step(Tracker &tracker, const InputHistory &history, float facing) const {
+  // Too slow, start over from the direction that is still held so a long held down still begins a motion
+  if (tracker.ticksSinceSymbol < MOTION_WINDOW_TICKS) {
+    ++tracker.ticksSinceSymbol;
+  } else {
+    tracker.state = transitionTable[static_cast<size_t>(tracker.lastDirection)];
+  }
+
+  SpecialMove completed = SpecialMove::NONE;
+
+  // Only changes of direction are symbols, holding a direction does not repeat it
+  MotionSymbol direction = directionSymbol(history.get(0), facing);
+  if (direction != tracker.lastDirection) {
+    tracker.lastDirection = direction;
+    completed = feed(tracker, direction);
+  }
+
+  if (history.wasPressed(PlayerAction::Punch)) {
+    SpecialMove move = feed(tracker, MotionSymbol::PUNCH);
+    if (move != SpecialMove::NONE)
+      completed = move;
+  }
+
+  return completed;
+}
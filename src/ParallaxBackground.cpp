@@ -0,0 +1,227 @@
+#include "ParallaxBackground.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "GameConfig.h"
+#include "managers/RenderManager.h"
+
+namespace {
+
+constexpr float TWO_PI = 6.28318530718f;
+
+uint32_t nextRandom(uint32_t &state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+float randomRange(uint32_t &state, float min, float max) {
+  return min + (max - min) * (nextRandom(state) % 10000) / 10000.0f;
+}
+
+// Sum of sines with whole periods across the width, so the left and right edges line up when wrapped
+float periodicHeight(float x, int width, uint32_t seed) {
+  float height = 0.0f;
+  float amplitude = 1.0f;
+  for (int harmonic = 1; harmonic <= 4; ++harmonic) {
+    float phase = randomRange(seed, 0.0f, TWO_PI);
+    int frequency = harmonic * 2 + static_cast<int>(nextRandom(seed) % 3);
+    height += amplitude * std::sin(TWO_PI * frequency * x / width + phase);
+    amplitude *= 0.5f;
+  }
+  return height / 1.875f;
+}
+
+void composeSky(SDL_Renderer *renderer, int width, int height) {
+  const SDL_Color top = {20, 10, 30, 255};
+  const SDL_Color horizon = {120, 24, 28, 255};
+
+  for (int y = 0; y < height; ++y) {
+    float t = std::min(1.0f, static_cast<float>(y) / (height * 0.8f));
+    SDL_SetRenderDrawColor(renderer,
+                           static_cast<Uint8>(top.r + (horizon.r - top.r) * t),
+                           static_cast<Uint8>(top.g + (horizon.g - top.g) * t),
+                           static_cast<Uint8>(top.b + (horizon.b - top.b) * t), 255);
+    SDL_FRect row = {0, static_cast<float>(y), static_cast<float>(width), 1};
+    SDL_RenderFillRect(renderer, &row);
+  }
+
+  // Moon
+  const float moonX = width * 0.7f;
+  const float moonY = height * 0.25f;
+  const float moonRadius = 28.0f;
+  SDL_SetRenderDrawColor(renderer, 230, 196, 184, 255);
+  for (int dy = -static_cast<int>(moonRadius); dy <= static_cast<int>(moonRadius); ++dy) {
+    float halfWidth = std::sqrt(moonRadius * moonRadius - dy * dy);
+    SDL_FRect span = {moonX - halfWidth, moonY + dy, halfWidth * 2.0f, 1};
+    SDL_RenderFillRect(renderer, &span);
+  }
+
+  // Stars
+  uint32_t seed = 0x5eed1234u;
+  SDL_SetRenderDrawColor(renderer, 220, 210, 230, 255);
+  for (int i = 0; i < 80; ++i) {
+    SDL_FRect star = {randomRange(seed, 0, width), randomRange(seed, 0, height * 0.5f), 1, 1};
+    SDL_RenderFillRect(renderer, &star);
+  }
+}
+
+void composeRidge(SDL_Renderer *renderer, int width, int height, SDL_Color color,
+                  float baseLine, float amplitude, uint32_t seed) {
+  std::vector<SDL_FRect> columns;
+  columns.reserve(width);
+
+  for (int x = 0; x < width; ++x) {
+    float top = baseLine - amplitude * periodicHeight(static_cast<float>(x), width, seed);
+    columns.push_back({static_cast<float>(x), top, 1.0f, height - top});
+  }
+
+  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  SDL_RenderFillRects(renderer, columns.data(), static_cast<int>(columns.size()));
+}
+
+void composeRuins(SDL_Renderer *renderer, int width, int height) {
+  uint32_t seed = 0xbadc0deu;
+  const float groundLine = height * GameConfig::PLAYER_Y_RATIO;
+
+  float x = 0.0f;
+  while (x < width) {
+    float buildingWidth = randomRange(seed, 24.0f, 56.0f);
+    float buildingHeight = randomRange(seed, 40.0f, 120.0f);
+
+    // Buildings crossing the right edge are drawn again on the left to keep the layer seamless
+    for (float wrapX : {x, x - width}) {
+      SDL_FRect building = {wrapX, groundLine - buildingHeight, buildingWidth, buildingHeight};
+      SDL_SetRenderDrawColor(renderer, 36, 16, 28, 255);
+      SDL_RenderFillRect(renderer, &building);
+
+      SDL_SetRenderDrawColor(renderer, 150, 60, 40, 255);
+      uint32_t windowSeed = static_cast<uint32_t>(x * 131.0f) | 1u;
+      for (float wy = building.y + 6; wy < groundLine - 8; wy += 10) {
+        for (float wx = building.x + 4; wx < building.x + building.w - 6; wx += 8) {
+          if (nextRandom(windowSeed) % 4 == 0) {
+            SDL_FRect lit = {wx, wy, 3, 4};
+            SDL_RenderFillRect(renderer, &lit);
+          }
+        }
+      }
+    }
+
+    x += buildingWidth + randomRange(seed, 4.0f, 20.0f);
+  }
+}
+
+void composeGround(SDL_Renderer *renderer, int width, int height) {
+  const float groundLine = height * GameConfig::PLAYER_Y_RATIO;
+
+  SDL_FRect ground = {0, groundLine, static_cast<float>(width), height - groundLine};
+  SDL_SetRenderDrawColor(renderer, 44, 22, 26, 255);
+  SDL_RenderFillRect(renderer, &ground);
+
+  SDL_FRect edge = {0, groundLine, static_cast<float>(width), 2};
+  SDL_SetRenderDrawColor(renderer, 90, 36, 34, 255);
+  SDL_RenderFillRect(renderer, &edge);
+
+  // Evenly spaced stones, the spacing divides the width so the pattern repeats cleanly
+  SDL_SetRenderDrawColor(renderer, 64, 30, 32, 255);
+  uint32_t seed = 0x9e3779b9u;
+  for (int x = 0; x < width; x += 16) {
+    SDL_FRect stone = {static_cast<float>(x) + randomRange(seed, 0, 10), groundLine + randomRange(seed, 6, height - groundLine - 4),
+                       randomRange(seed, 2, 6), 2};
+    SDL_RenderFillRect(renderer, &stone);
+  }
+}
+
+}  // namespace
+
+ParallaxBackground::ParallaxBackground(SDL_Renderer *renderer) : renderer(renderer) {
+}
+
+ParallaxBackground::~ParallaxBackground() {
+}
+
+std::unique_ptr<ParallaxBackground> ParallaxBackground::createStage(SDL_Renderer *renderer) {
+  auto background = std::make_unique<ParallaxBackground>(renderer);
+
+  background->addLayer(0.0f, 0.0f, composeSky);
+  background->addLayer(0.15f, 0.0f, [](SDL_Renderer *renderer, int width, int height) {
+    composeRidge(renderer, width, height, {58, 18, 36, 255}, height * 0.62f, 40.0f, 0xa341316cu);
+  });
+  background->addLayer(0.35f, 0.0f, [](SDL_Renderer *renderer, int width, int height) {
+    composeRidge(renderer, width, height, {40, 14, 28, 255}, height * 0.74f, 26.0f, 0xc8013ea4u);
+  });
+  background->addLayer(0.6f, 0.0f, composeRuins);
+  background->addLayer(1.0f, 0.0f, composeGround);
+
+  return background;
+}
+
+std::unique_ptr<ParallaxBackground> ParallaxBackground::createMainMenu(SDL_Renderer *renderer) {
+  auto background = std::make_unique<ParallaxBackground>(renderer);
+
+  background->addLayer(0.0f, 0.0f, composeSky);
+  background->addLayer(0.0f, 6.0f, [](SDL_Renderer *renderer, int width, int height) {
+    composeRidge(renderer, width, height, {58, 18, 36, 255}, height * 0.62f, 40.0f, 0xa341316cu);
+  });
+  background->addLayer(0.0f, 14.0f, [](SDL_Renderer *renderer, int width, int height) {
+    composeRidge(renderer, width, height, {40, 14, 28, 255}, height * 0.74f, 26.0f, 0xc8013ea4u);
+  });
+  background->addLayer(0.0f, 28.0f, composeRuins);
+
+  return background;
+}
+
+bool ParallaxBackground::addLayer(float scrollFactor, float autoScrollSpeed, const ComposeFunction &compose) {
+  if (!renderer)
+    return false;
+
+  const int width = GameConfig::LOGICAL_WIDTH;
+  const int height = GameConfig::LOGICAL_HEIGHT;
+
+  unique_texture texture(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height));
+  if (!texture) {
+    std::cerr << "Failed to create parallax layer texture: " << SDL_GetError() << '\n';
+    return false;
+  }
+
+  SDL_SetTextureScaleMode(texture.get(), SDL_SCALEMODE_NEAREST);
+  SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+
+  SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+  SDL_SetRenderTarget(renderer, texture.get());
+
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  SDL_RenderClear(renderer);
+
+  compose(renderer, width, height);
+
+  SDL_SetRenderTarget(renderer, previousTarget);
+
+  layers.push_back({std::move(texture), scrollFactor, autoScrollSpeed, 0.0f});
+  return true;
+}
+
+void ParallaxBackground::update(float deltaTime) {
+  for (auto &layer : layers) {
+    if (layer.autoScrollSpeed != 0.0f) {
+      layer.autoScrollOffset = std::fmod(layer.autoScrollOffset + layer.autoScrollSpeed * deltaTime,
+                                         static_cast<float>(GameConfig::LOGICAL_WIDTH));
+    }
+  }
+}
+
+void ParallaxBackground::render() const {
+  RenderManager &renderManager = RenderManager::getInstance();
+
+  const SDL_FRect screen = {0, 0, GameConfig::LOGICAL_WIDTH, GameConfig::LOGICAL_HEIGHT};
+
+  for (size_t i = 0; i < layers.size(); ++i) {
+    const ParallaxLayer &layer = layers[i];
+    float offset = scrollX * layer.scrollFactor + layer.autoScrollOffset;
+    renderManager.drawTextureWrapped(backgroundLayer(static_cast<int>(i)), layer.texture.get(), offset, screen);
+  }
+}
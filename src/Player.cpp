@@ -5,11 +5,13 @@
 #include <iostream>
 
 #include "GameConfig.h"
-#include "managers/DebugManager.h"
+#include "managers/DebugDraw.h"
+#include "managers/RenderManager.h"
 #include "managers/ResourceManager.h"
+#include "utils/Profiler.h"
 
 Player::Player(bool primaryPlayer)
-    : primaryPlayer(primaryPlayer), spriteFrame(1), currentAnimation(0) {
+    : primaryPlayer(primaryPlayer), animState(static_cast<StateId>(PlayerAnimState::IDLE)), pendingTriggers(0) {
   ResourceManager &resources = ResourceManager::getInstance();
 
   moveSpeed = 200.0f;  // pixels per second
@@ -18,51 +20,62 @@ Player::Player(bool primaryPlayer)
   isActivelyMoving = false;
   velocity = glm::vec2(0, 0);
 
-  if (primaryPlayer) {
-    position = glm::vec2(GameConfig::LOGICAL_WIDTH * GameConfig::PLAYER1_X_RATIO, GameConfig::LOGICAL_HEIGHT * GameConfig::PLAYER_Y_RATIO);
-
-    idleTexture = resources.getTexture("resources/textures/player1/idle.png");
-    runTexture = resources.getTexture("resources/textures/player1/run.png");
-    takingPunchTexture = resources.getTexture("resources/textures/player1/taking-punch.png");
+  // Spawn ratios are relative to the screen-sized area in the middle of the stage
+  float spawnOriginX = (GameConfig::STAGE_WIDTH - GameConfig::LOGICAL_WIDTH) * 0.5f;
 
+  if (primaryPlayer) {
+    position = glm::vec2(spawnOriginX + GameConfig::LOGICAL_WIDTH * GameConfig::PLAYER1_X_RATIO, GameConfig::LOGICAL_HEIGHT * GameConfig::PLAYER_Y_RATIO);
     direction = 1;
   } else {
-    position = glm::vec2(GameConfig::LOGICAL_WIDTH * GameConfig::PLAYER2_X_RATIO, GameConfig::LOGICAL_HEIGHT * GameConfig::PLAYER_Y_RATIO);
-
-    idleTexture = resources.getTexture("resources/textures/player1/idle.png");
-    runTexture = resources.getTexture("resources/textures/player1/run.png");
-    takingPunchTexture = resources.getTexture("resources/textures/player1/taking-punch.png");
-
+    position = glm::vec2(spawnOriginX + GameConfig::LOGICAL_WIDTH * GameConfig::PLAYER2_X_RATIO, GameConfig::LOGICAL_HEIGHT * GameConfig::PLAYER_Y_RATIO);
     direction = -1;
   }
 
-  animations.resize(3);
-  animations = resources.getPlayerAnimations(primaryPlayer);
+  // One texture per state, indexed by state id so rendering never branches on the animation
+  stateMachine = &resources.getPlayerStateMachine(primaryPlayer);
+  stateTextures.reserve(stateMachine->getStateCount());
+  for (size_t state = 0; state < stateMachine->getStateCount(); ++state) {
+    stateTextures.push_back(resources.getTexture(stateMachine->getState(static_cast<StateId>(state)).texture));
+  }
+  playhead.play(stateMachine->getState(animState).clip);
 
-  if (idleTexture) {
-    float textureWidth, textureHeight;
-    SDL_GetTextureSize(idleTexture.get(), &textureWidth, &textureHeight);
+  // Textures may still be decoding, the hitbox is derived from the idle frame once it has arrived
+  hitbox = SDL_FRect{.x = 10, .y = 10, .w = 32, .h = 48};
+  hitboxResolved = false;
+  resolveHitbox();
+}
 
-    float frameWidth = textureWidth;
-    if (!animations.empty()) {
-      frameWidth = textureWidth / animations[0].getFrameCount();
-    }
+Player::~Player() {
+}
 
-    hitbox = SDL_FRect{
-        .x = frameWidth * 0.2f,
-        .y = textureHeight * 0.1f,
-        .w = frameWidth * 0.6f,
-        .h = textureHeight * 0.8f};
-  } else {
-    hitbox = SDL_FRect{.x = 10, .y = 10, .w = 32, .h = 48};
+void Player::resolveHitbox() {
+  const TextureHandle &idleTexture = stateTextures[static_cast<size_t>(PlayerAnimState::IDLE)];
+  if (hitboxResolved || !idleTexture)
+    return;
+
+  hitboxResolved = true;
+
+  if (const SDL_FRect *cookedHitbox = idleTexture.getHitbox()) {
+    hitbox = *cookedHitbox;
+    return;
   }
-}
 
-Player::~Player() {
+  float textureHeight = idleTexture.getHeight();
+  float frameWidth = idleTexture.getWidth() * stateMachine->getState(static_cast<StateId>(PlayerAnimState::IDLE)).clip->getFrameUV(0).w;
+
+  hitbox = SDL_FRect{
+      .x = frameWidth * 0.2f,
+      .y = textureHeight * 0.1f,
+      .w = frameWidth * 0.6f,
+      .h = textureHeight * 0.8f};
 }
 
 void Player::update(float deltaTime) {
-  if (!isActivelyMoving) {
+  resolveHitbox();
+
+  if (specialTimeLeft > 0.0f) {
+    specialTimeLeft -= deltaTime;
+  } else if (!isActivelyMoving) {
     velocity.x *= 0.85f;
 
     if (abs(velocity.x) < 10.0f) {
@@ -81,70 +94,56 @@ void Player::update(float deltaTime) {
     velocity.y = (velocity.y > 0) ? maxSpeed : -maxSpeed;
   }
 
-  if (isActivelyMoving) {
-    if (currentAnimation != 1) {
-      playRunAnimation();
-    }
-  } else if (abs(velocity.x) < 20.0f) {
-    if (currentAnimation == 1) {
-      playIdleAnimation();
-    }
-  }
+  uint8_t conditions = pendingTriggers;
+  pendingTriggers = 0;
 
-  if (currentAnimation >= 0 && currentAnimation < animations.size()) {
-    animations[currentAnimation].step(deltaTime);
+  if (isActivelyMoving)
+    conditions |= conditionMask(AnimationCondition::MOVING);
+  if (abs(velocity.x) < 20.0f)
+    conditions |= conditionMask(AnimationCondition::STOPPED);
+  if (playhead.isDone())
+    conditions |= conditionMask(AnimationCondition::CLIP_DONE);
+  if (isGrounded)
+    conditions |= conditionMask(AnimationCondition::GROUNDED);
 
-    if (animations[currentAnimation].isDone() && currentAnimation == 2) {
-      setAnimation(0);
-    }
-  }
+  enterState(stateMachine->next(animState, conditions));
+
+  playhead.step(deltaTime);
+}
+
+void Player::triggerAnimation(AnimationCondition trigger) {
+  // Evaluated immediately so the new state is visible to the rest of this tick
+  enterState(stateMachine->next(animState, conditionMask(trigger)));
 }
 
-void Player::setAnimation(int animationIndex) {
-  if (animationIndex >= 0 && animationIndex < animations.size() && animationIndex != currentAnimation) {
-    currentAnimation = animationIndex;
-    animations[currentAnimation].reset();
+void Player::enterState(StateId state) {
+  if (state != animState) {
+    animState = state;
+    playhead.play(stateMachine->getState(animState).clip);
   }
 }
 
-void Player::render(SDL_Renderer *renderer) {
-  shared_texture currentTexture;
+void Player::render() {
+  PROFILE_ZONE("Player::render");
 
-  if (currentAnimation == 0) {  // Idle
-    currentTexture = idleTexture;
-  } else if (currentAnimation == 1) {  // Run
-    currentTexture = runTexture;
-  } else if (currentAnimation == 2) {  // Taking punch
-    currentTexture = takingPunchTexture;
-  } else {
-    currentTexture = idleTexture;  // Default to idle
-  }
+  const TextureHandle &currentTexture = stateTextures[animState];
 
   if (!currentTexture) {
     return;
   }
 
-  float textureWidth, textureHeight;
-  SDL_GetTextureSize(currentTexture.get(), &textureWidth, &textureHeight);
-
-  float frameWidth = textureWidth;
-  if (currentAnimation >= 0 && currentAnimation < animations.size()) {
-    frameWidth = textureWidth / animations[currentAnimation].getFrameCount();
-  }
+  float textureWidth = currentTexture.getWidth();
+  float textureHeight = currentTexture.getHeight();
 
-  float srcX = 0;
-  if (currentAnimation >= 0 && currentAnimation < animations.size()) {
-    int frame = animations[currentAnimation].currentFrame();
-    srcX = frame * frameWidth;
-  } else {
-    srcX = (spriteFrame - 1) * frameWidth;
-  }
+  int frame = playhead.currentFrame();
+  const SDL_FRect &uv = playhead.getClip()->getFrameUV(frame);
+  float frameWidth = uv.w * textureWidth;
 
   SDL_FRect src{
-      .x = srcX,
-      .y = 0,
+      .x = uv.x * textureWidth,
+      .y = uv.y * textureHeight,
       .w = frameWidth,
-      .h = textureHeight};
+      .h = uv.h * textureHeight};
 
   SDL_FRect dst{
       .x = position.x,
@@ -152,23 +151,33 @@ void Player::render(SDL_Renderer *renderer) {
       .w = frameWidth,
       .h = textureHeight};
 
-  SDL_FlipMode flipMode = direction == -1 ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-  SDL_RenderTextureRotated(renderer, currentTexture.get(), &src, &dst, 0, nullptr, flipMode);
-
-  if (DebugManager::getInstance().isDebugMode()) {
-    SDL_FRect rectA{
-        .x = position.x + hitbox.x,
-        .y = position.y - textureHeight + hitbox.y,
-        .w = hitbox.w,
-        .h = hitbox.h};
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 150);
-    SDL_RenderFillRect(renderer, &rectA);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+  bool flipped = direction == -1;
+
+  // Cooked frames only draw their opaque pixels, mirrored inside the frame along with the sprite
+  if (const SDL_FRect *bounds = currentTexture.getFrameBounds(frame)) {
+    if (bounds->w <= 0 || bounds->h <= 0)
+      return;
+
+    float boundsX = flipped ? frameWidth - bounds->x - bounds->w : bounds->x;
+    src = SDL_FRect{src.x + bounds->x, src.y + bounds->y, bounds->w, bounds->h};
+    dst = SDL_FRect{dst.x + boundsX, dst.y + bounds->y, bounds->w, bounds->h};
+  }
+
+  RenderManager &renderManager = RenderManager::getInstance();
+
+  // Feet position as depth so the fighter lower on screen is drawn in front
+  SDL_FlipMode flipMode = flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+  renderManager.drawTexture(RenderLayer::WORLD, currentTexture.get(), &src, dst, position.y, flipMode);
+
+  if (DebugDraw::getInstance().isEnabled()) {
+    DebugDraw::getInstance().fillRect(getWorldHitbox(), {255, 0, 0, 150});
   }
 }
 
 void Player::move(float direction) {
+  if (specialTimeLeft > 0.0f)
+    return;
+
   velocity.x = direction * moveSpeed;
   isActivelyMoving = true;
 
@@ -176,39 +185,60 @@ void Player::move(float direction) {
 }
 
 void Player::jump() {
+  pendingTriggers |= conditionMask(AnimationCondition::JUMP);
 }
 
 void Player::punch() {
+  pendingTriggers |= conditionMask(AnimationCondition::PUNCH);
 }
 
 void Player::stopMoving() {
   isActivelyMoving = false;
 }
 
-SDL_FRect Player::getWorldHitbox() const {
-  shared_texture currentTexture = idleTexture;
-  if (currentAnimation == 1) {
-    currentTexture = runTexture;
-  } else if (currentAnimation == 2) {
-    currentTexture = takingPunchTexture;
+void Player::performSpecial(SpecialMove move, float facing) {
+  const float SPECIAL_DURATION = 0.25f;  // seconds
+  const float LUNGE_SPEED = 450.0f;
+  const float RETREAT_SPEED = 300.0f;
+
+  switch (move) {
+    case SpecialMove::LUNGE_PUNCH:
+      velocity.x = facing * LUNGE_SPEED;
+      break;
+    case SpecialMove::RETREAT_PUNCH:
+      velocity.x = -facing * RETREAT_SPEED;
+      break;
+    default:
+      return;
   }
 
-  float textureHeight = 48.0f;
-  if (currentTexture) {
-    float textureWidth, tempHeight;
-    SDL_GetTextureSize(currentTexture.get(), &textureWidth, &tempHeight);
-    textureHeight = tempHeight;
+  direction = facing;
+  specialTimeLeft = SPECIAL_DURATION;
+  lastSpecial = move;
+  punch();
+}
+
+SDL_FRect Player::getWorldHitbox() const {
+  const TextureHandle &currentTexture = stateTextures[animState];
+
+  float textureHeight = currentTexture ? currentTexture.getHeight() : 48.0f;
+
+  // The hitbox is in frame space of the unflipped sprite, mirror it inside the frame when facing left
+  float hitboxX = hitbox.x;
+  if (direction == -1 && currentTexture) {
+    float frameWidth = currentTexture.getWidth() * playhead.getClip()->getFrameUV(playhead.currentFrame()).w;
+    hitboxX = frameWidth - hitbox.x - hitbox.w;
   }
 
   return SDL_FRect{
-      .x = position.x + hitbox.x,
+      .x = position.x + hitboxX,
       .y = position.y - textureHeight + hitbox.y,
       .w = hitbox.w,
       .h = hitbox.h};
 }
 
 SDL_FRect Player::getAttackBox() const {
-  if (currentAnimation != 2) {
+  if (getCurrentAnimation() != PlayerAnimState::TAKING_PUNCH) {
     return SDL_FRect{0, 0, 0, 0};
   }
 
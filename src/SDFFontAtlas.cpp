@@ -0,0 +1,156 @@
+#include "SDFFontAtlas.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int ATLAS_WIDTH = 512;
+constexpr int GLYPH_PADDING = 1;
+
+// The fixed-function renderer can't threshold the distance per pixel, so the ramp
+// around the edge (alpha 128) is steepened once here. Linear filtering of the scaled
+// quads then still gives a narrow, sharp edge at any size.
+constexpr float EDGE_STEEPNESS = 4.0f;
+
+void steepenEdges(SDL_Surface *surface) {
+  for (int y = 0; y < surface->h; ++y) {
+    uint8_t *row = static_cast<uint8_t *>(surface->pixels) + y * surface->pitch;
+    for (int x = 0; x < surface->w; ++x) {
+      uint8_t *pixel = row + x * 4;
+      float alpha = (pixel[3] - 128.0f) * EDGE_STEEPNESS + 128.0f;
+
+      // White texels, the colour comes from the texture colour mod when drawing
+      pixel[0] = pixel[1] = pixel[2] = 255;
+      pixel[3] = static_cast<uint8_t>(std::clamp(alpha, 0.0f, 255.0f));
+    }
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<SDFFontAtlas> SDFFontAtlas::build(TTF_Font *font, float rasterSize) {
+  std::unique_ptr<SDFFontAtlas> atlas(new SDFFontAtlas());
+  atlas->rasterSize = rasterSize;
+  atlas->lineHeight = static_cast<float>(TTF_GetFontHeight(font));
+
+  // Rasterise every glyph first, then shelf-pack them into rows
+  std::vector<unique_surface> glyphSurfaces(atlas->glyphs.size());
+  int penX = 0, penY = 0, shelfHeight = 0;
+
+  for (size_t i = 0; i < atlas->glyphs.size(); ++i) {
+    Uint32 codepoint = static_cast<Uint32>(FIRST_GLYPH + i);
+
+    int minX, maxX, minY, maxY, advance;
+    if (!TTF_GetGlyphMetrics(font, codepoint, &minX, &maxX, &minY, &maxY, &advance))
+      continue;
+
+    SDFGlyph &glyph = atlas->glyphs[i];
+    glyph.advance = static_cast<float>(advance);
+
+    unique_surface rendered(TTF_RenderGlyph_Blended(font, codepoint, {255, 255, 255, 255}));
+    if (!rendered)
+      continue;
+
+    glyphSurfaces[i] = unique_surface(SDL_ConvertSurface(rendered.get(), SDL_PIXELFORMAT_RGBA32));
+    SDL_Surface *surface = glyphSurfaces[i].get();
+    if (!surface)
+      continue;
+
+    if (penX + surface->w > ATLAS_WIDTH) {
+      penX = 0;
+      penY += shelfHeight + GLYPH_PADDING;
+      shelfHeight = 0;
+    }
+
+    glyph.src = {static_cast<float>(penX), static_cast<float>(penY), static_cast<float>(surface->w),
+                 static_cast<float>(surface->h)};
+    glyph.valid = true;
+
+    penX += surface->w + GLYPH_PADDING;
+    shelfHeight = std::max(shelfHeight, surface->h);
+  }
+
+  atlas->atlasSurface = unique_surface(SDL_CreateSurface(ATLAS_WIDTH, penY + shelfHeight, SDL_PIXELFORMAT_RGBA32));
+  SDL_Surface *atlasSurface = atlas->atlasSurface.get();
+  if (!atlasSurface) {
+    std::cerr << "Failed to create font atlas surface: " << SDL_GetError() << '\n';
+    return nullptr;
+  }
+  SDL_FillSurfaceRect(atlasSurface, nullptr, 0);
+
+  for (size_t i = 0; i < atlas->glyphs.size(); ++i) {
+    if (!atlas->glyphs[i].valid)
+      continue;
+
+    SDL_Surface *surface = glyphSurfaces[i].get();
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+
+    SDL_Rect dst = {static_cast<int>(atlas->glyphs[i].src.x), static_cast<int>(atlas->glyphs[i].src.y), surface->w, surface->h};
+    SDL_BlitSurface(surface, nullptr, atlasSurface, &dst);
+  }
+
+  steepenEdges(atlasSurface);
+
+  return atlas;
+}
+
+bool SDFFontAtlas::upload(SDL_Renderer *renderer) {
+  if (texture)
+    return true;
+  if (!atlasSurface)
+    return false;
+
+  texture = unique_texture(SDL_CreateTextureFromSurface(renderer, atlasSurface.get()));
+  if (!texture) {
+    std::cerr << "Failed to create font atlas texture: " << SDL_GetError() << '\n';
+    return false;
+  }
+  SDL_SetTextureScaleMode(texture.get(), SDL_SCALEMODE_LINEAR);
+
+  // The pixels live on the GPU from now on
+  atlasSurface.reset();
+  return true;
+}
+
+const SDFGlyph *SDFFontAtlas::findGlyph(char c) const {
+  if (c < FIRST_GLYPH || c > LAST_GLYPH)
+    return nullptr;
+
+  const SDFGlyph &glyph = glyphs[c - FIRST_GLYPH];
+  return glyph.valid ? &glyph : nullptr;
+}
+
+void SDFFontAtlas::drawText(RenderLayer layer, float x, float y, std::string_view text, float size, SDL_Color color,
+                            float depth) const {
+  RenderManager &renderManager = RenderManager::getInstance();
+
+  const float scale = size / rasterSize;
+  float penX = x;
+
+  for (char c : text) {
+    const SDFGlyph *glyph = findGlyph(c);
+    if (!glyph)
+      continue;
+
+    if (c != ' ') {
+      SDL_FRect dst = {penX, y, glyph->src.w * scale, glyph->src.h * scale};
+      renderManager.drawTexture(layer, texture.get(), &glyph->src, dst, depth, SDL_FLIP_NONE, color);
+    }
+    penX += glyph->advance * scale;
+  }
+}
+
+SDL_FPoint SDFFontAtlas::measureText(std::string_view text, float size) const {
+  const float scale = size / rasterSize;
+  float width = 0.0f;
+
+  for (char c : text) {
+    if (const SDFGlyph *glyph = findGlyph(c)) {
+      width += glyph->advance * scale;
+    }
+  }
+
+  return SDL_FPoint{width, lineHeight * scale};
+}
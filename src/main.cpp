@@ -3,9 +3,20 @@
 #include <iostream>
 
 #include "Game.h"
+#include "LaunchOptions.h"
+#include "managers/RenderBackendManager.h"
 
 int main(int argc, char *argv[]) {
-  Game game;
+  LaunchOptions options = LaunchOptions::parse(argc, argv);
+
+  if (options.listRenderers) {
+    for (const auto &driver : RenderBackendManager::getInstance().getAvailableDrivers()) {
+      std::cout << driver << '\n';
+    }
+    return 0;
+  }
+
+  Game game(options);
   game.run();
 
   return 0;
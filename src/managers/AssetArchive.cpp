@@ -0,0 +1,190 @@
+#include "managers/AssetArchive.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "utils/AssetArchiveFormat.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetArchive::AssetArchive() {
+}
+
+AssetArchive::~AssetArchive() {
+  close();
+}
+
+bool AssetArchive::open(const std::string &archivePath) {
+  close();
+
+  if (!mapFile(archivePath)) {
+    return false;
+  }
+
+  if (!readIndex()) {
+    std::cerr << "Invalid asset archive: " << archivePath << '\n';
+    close();
+    return false;
+  }
+
+  return true;
+}
+
+void AssetArchive::close() {
+  assets.clear();
+  unmapFile();
+}
+
+bool AssetArchive::find(std::string_view path, AssetView &view) const {
+  auto it = assets.find(path);
+  if (it == assets.end()) {
+    return false;
+  }
+
+  view = it->second;
+  return true;
+}
+
+SDL_IOStream *AssetArchive::openIO(const std::string &path) const {
+  AssetView view;
+  if (find(path, view)) {
+    return SDL_IOFromConstMem(view.data, view.size);
+  }
+
+  return SDL_IOFromFile(path.c_str(), "rb");
+}
+
+bool AssetArchive::readIndex() {
+  using namespace AssetArchiveFormat;
+
+  if (mappedSize < sizeof(ArchiveHeader)) {
+    return false;
+  }
+
+  ArchiveHeader header;
+  std::memcpy(&header, mappedData, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+    return false;
+  }
+
+  uint64_t indexEnd = sizeof(ArchiveHeader) + static_cast<uint64_t>(header.entryCount) * sizeof(ArchiveEntry);
+  if (indexEnd > mappedSize) {
+    return false;
+  }
+
+  assets.reserve(header.entryCount);
+  for (uint32_t i = 0; i < header.entryCount; ++i) {
+    ArchiveEntry entry;
+    std::memcpy(&entry, mappedData + sizeof(ArchiveHeader) + i * sizeof(ArchiveEntry), sizeof(entry));
+
+    if (static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > mappedSize ||
+        entry.dataOffset > mappedSize || entry.dataSize > mappedSize - entry.dataOffset) {
+      return false;
+    }
+
+    std::string_view path(reinterpret_cast<const char *>(mappedData + entry.pathOffset), entry.pathLength);
+    assets[path] = AssetView{mappedData + entry.dataOffset, static_cast<size_t>(entry.dataSize)};
+  }
+
+  return true;
+}
+
+#ifdef _WIN32
+
+bool AssetArchive::mapFile(const std::string &archivePath) {
+  HANDLE file = CreateFileA(archivePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    CloseHandle(file);
+    return false;
+  }
+
+  void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  fileHandle = file;
+  mappingHandle = mapping;
+  mappedData = static_cast<const uint8_t *>(view);
+  mappedSize = static_cast<size_t>(size.QuadPart);
+  return true;
+}
+
+void AssetArchive::unmapFile() {
+  if (mappedData) {
+    UnmapViewOfFile(mappedData);
+  }
+  if (mappingHandle) {
+    CloseHandle(mappingHandle);
+  }
+  if (fileHandle) {
+    CloseHandle(fileHandle);
+  }
+
+  mappedData = nullptr;
+  mappedSize = 0;
+  mappingHandle = nullptr;
+  fileHandle = nullptr;
+}
+
+#else
+
+bool AssetArchive::mapFile(const std::string &archivePath) {
+  int fd = ::open(archivePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat fileInfo;
+  if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void *view = mmap(nullptr, static_cast<size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  if (view == MAP_FAILED) {
+    ::close(fd);
+    return false;
+  }
+
+  fileDescriptor = fd;
+  mappedData = static_cast<const uint8_t *>(view);
+  mappedSize = static_cast<size_t>(fileInfo.st_size);
+  return true;
+}
+
+void AssetArchive::unmapFile() {
+  if (mappedData) {
+    munmap(const_cast<uint8_t *>(mappedData), mappedSize);
+  }
+  if (fileDescriptor >= 0) {
+    ::close(fileDescriptor);
+  }
+
+  mappedData = nullptr;
+  mappedSize = 0;
+  fileDescriptor = -1;
+}
+
+#endif
@@ -0,0 +1,126 @@
+#include "managers/AssetWatcher.h"
+
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+AssetWatcher::AssetWatcher() {
+}
+
+AssetWatcher::~AssetWatcher() {
+  stop();
+}
+
+#ifdef __linux__
+
+bool AssetWatcher::start(const std::string &rootDirectory, ChangeCallback onChanged) {
+  stop();
+
+  inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotifyDescriptor < 0) {
+    std::cerr << "Failed to initialize inotify for " << rootDirectory << '\n';
+    return false;
+  }
+
+  addWatchRecursive(rootDirectory);
+  if (watchedDirectories.empty()) {
+    close(inotifyDescriptor);
+    inotifyDescriptor = -1;
+    return false;
+  }
+
+  this->onChanged = std::move(onChanged);
+  running = true;
+  watchThread = std::thread([this]() { watchLoop(); });
+
+  std::cout << "Watching " << watchedDirectories.size() << " asset directories for changes" << '\n';
+  return true;
+}
+
+void AssetWatcher::stop() {
+  running = false;
+  if (watchThread.joinable()) {
+    watchThread.join();
+  }
+
+  if (inotifyDescriptor >= 0) {
+    close(inotifyDescriptor);
+    inotifyDescriptor = -1;
+  }
+  watchedDirectories.clear();
+}
+
+void AssetWatcher::addWatchRecursive(const std::string &directory) {
+  std::error_code error;
+  if (!std::filesystem::is_directory(directory, error))
+    return;
+
+  // Editors usually save through a temporary file and a rename, hence IN_MOVED_TO
+  int watch = inotify_add_watch(inotifyDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+  if (watch < 0) {
+    std::cerr << "Failed to watch " << directory << '\n';
+    return;
+  }
+  watchedDirectories[watch] = directory;
+
+  for (const auto &entry : std::filesystem::directory_iterator(directory, error)) {
+    if (entry.is_directory()) {
+      addWatchRecursive(entry.path().generic_string());
+    }
+  }
+}
+
+void AssetWatcher::watchLoop() {
+  alignas(inotify_event) char buffer[4096];
+
+  while (running) {
+    // Short timeout so stop() never waits long for the thread
+    pollfd descriptor = {inotifyDescriptor, POLLIN, 0};
+    if (poll(&descriptor, 1, 100) <= 0)
+      continue;
+
+    ssize_t length = read(inotifyDescriptor, buffer, sizeof(buffer));
+    for (ssize_t offset = 0; offset < length;) {
+      const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+      offset += sizeof(inotify_event) + event->len;
+
+      auto directory = watchedDirectories.find(event->wd);
+      if (directory == watchedDirectories.end() || event->len == 0)
+        continue;
+
+      std::string path = directory->second + "/" + event->name;
+
+      if (event->mask & IN_ISDIR) {
+        if (event->mask & IN_CREATE) {
+          addWatchRecursive(path);
+        }
+      } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+        onChanged(path);
+      }
+    }
+  }
+}
+
+#else
+
+bool AssetWatcher::start(const std::string &rootDirectory, ChangeCallback onChanged) {
+  std::cerr << "Asset hot reload is only supported on Linux, not watching " << rootDirectory << '\n';
+  return false;
+}
+
+void AssetWatcher::stop() {
+  running = false;
+}
+
+void AssetWatcher::addWatchRecursive(const std::string &directory) {
+}
+
+void AssetWatcher::watchLoop() {
+}
+
+#endif
@@ -144,7 +144,7 @@ void CollisionManager::checkPlayerAttackCollisions(Player *attacker, Player *def
   if (!attacker || !defender)
     return;
 
-  if (attacker->getCurrentAnimation() != 2)
+  if (attacker->getCurrentAnimation() != PlayerAnimState::TAKING_PUNCH)
     return;
 
   SDL_FRect attackBox = attacker->getAttackBox();
@@ -279,7 +279,7 @@ void CollisionManager::resolveAttackHit(Player *attacker, Player *defender) {
   if (!attacker || !defender)
     return;
 
-  defender->playTakingPunchAnimation();
+  defender->triggerAnimation(AnimationCondition::HIT);
 
   glm::vec2 attackerPos = attacker->getPosition();
   glm::vec2 defenderPos = defender->getPosition();
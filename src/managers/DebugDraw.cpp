@@ -0,0 +1,177 @@
+#include "managers/DebugDraw.h"
+
+#include <cmath>
+
+#include "managers/RenderManager.h"
+
+namespace {
+
+SDL_FColor toFColor(SDL_Color color) {
+  return SDL_FColor{color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+}
+
+}  // namespace
+
+DebugDraw &DebugDraw::getInstance() {
+  static DebugDraw instance;
+  return instance;
+}
+
+DebugDraw::DebugDraw() {
+  vertices.reserve(INITIAL_VERTEX_CAPACITY);
+  indices.reserve(INITIAL_VERTEX_CAPACITY / 4 * 6);
+  submittedVertices.reserve(INITIAL_VERTEX_CAPACITY);
+  submittedIndices.reserve(INITIAL_VERTEX_CAPACITY / 4 * 6);
+}
+
+void DebugDraw::setEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(mutex);
+  this->enabled.store(enabled, std::memory_order_relaxed);
+
+  if (!enabled) {
+    vertices.clear();
+    indices.clear();
+    texts.clear();
+    textChars.clear();
+  }
+}
+
+void DebugDraw::addQuad(glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d, SDL_Color color) {
+  SDL_FColor fcolor = toFColor(color);
+  int first = static_cast<int>(vertices.size());
+
+  vertices.push_back({{a.x, a.y}, fcolor, {0.0f, 0.0f}});
+  vertices.push_back({{b.x, b.y}, fcolor, {0.0f, 0.0f}});
+  vertices.push_back({{c.x, c.y}, fcolor, {0.0f, 0.0f}});
+  vertices.push_back({{d.x, d.y}, fcolor, {0.0f, 0.0f}});
+
+  const int quadIndices[6] = {0, 1, 2, 0, 2, 3};
+  for (int index : quadIndices) {
+    indices.push_back(first + index);
+  }
+}
+
+void DebugDraw::addLine(glm::vec2 from, glm::vec2 to, SDL_Color color, float thickness) {
+  glm::vec2 delta = to - from;
+  float length = glm::length(delta);
+  if (length <= 0.0f)
+    return;
+
+  // Quad around the segment, thickness is in world units
+  glm::vec2 side = glm::vec2(-delta.y, delta.x) / length * (thickness * 0.5f);
+  addQuad(from + side, to + side, to - side, from - side, color);
+}
+
+void DebugDraw::fillRect(const SDL_FRect &rect, SDL_Color color) {
+  if (!isEnabled())
+    return;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  addQuad({rect.x, rect.y}, {rect.x + rect.w, rect.y}, {rect.x + rect.w, rect.y + rect.h},
+          {rect.x, rect.y + rect.h}, color);
+}
+
+void DebugDraw::rect(const SDL_FRect &rect, SDL_Color color, float thickness) {
+  if (!isEnabled())
+    return;
+
+  // Four bands inside the rect so the corners are not drawn twice
+  float right = rect.x + rect.w;
+  float bottom = rect.y + rect.h;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  addQuad({rect.x, rect.y}, {right, rect.y}, {right, rect.y + thickness}, {rect.x, rect.y + thickness}, color);
+  addQuad({rect.x, bottom - thickness}, {right, bottom - thickness}, {right, bottom}, {rect.x, bottom}, color);
+  addQuad({rect.x, rect.y + thickness}, {rect.x + thickness, rect.y + thickness},
+          {rect.x + thickness, bottom - thickness}, {rect.x, bottom - thickness}, color);
+  addQuad({right - thickness, rect.y + thickness}, {right, rect.y + thickness}, {right, bottom - thickness},
+          {right - thickness, bottom - thickness}, color);
+}
+
+void DebugDraw::line(glm::vec2 from, glm::vec2 to, SDL_Color color, float thickness) {
+  if (!isEnabled())
+    return;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  addLine(from, to, color, thickness);
+}
+
+void DebugDraw::circle(glm::vec2 center, float radius, SDL_Color color, float thickness) {
+  if (!isEnabled())
+    return;
+
+  const float STEP = 2.0f * 3.14159265f / CIRCLE_SEGMENTS;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  glm::vec2 previous = center + glm::vec2(radius, 0.0f);
+  for (int segment = 1; segment <= CIRCLE_SEGMENTS; ++segment) {
+    float angle = segment * STEP;
+    glm::vec2 next = center + glm::vec2(std::cos(angle), std::sin(angle)) * radius;
+    addLine(previous, next, color, thickness);
+    previous = next;
+  }
+}
+
+void DebugDraw::arrow(glm::vec2 from, glm::vec2 to, SDL_Color color, float thickness) {
+  if (!isEnabled())
+    return;
+
+  glm::vec2 delta = to - from;
+  float length = glm::length(delta);
+  if (length <= 0.0f)
+    return;
+
+  glm::vec2 direction = delta / length;
+  glm::vec2 side(-direction.y, direction.x);
+  glm::vec2 headBase = to - direction * ARROW_HEAD_SIZE;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  addLine(from, to, color, thickness);
+  addLine(to, headBase + side * (ARROW_HEAD_SIZE * 0.5f), color, thickness);
+  addLine(to, headBase - side * (ARROW_HEAD_SIZE * 0.5f), color, thickness);
+}
+
+void DebugDraw::text(glm::vec2 position, std::string_view message, SDL_Color color) {
+  if (!isEnabled())
+    return;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  texts.push_back({position, textChars.size(), color});
+  textChars.insert(textChars.end(), message.begin(), message.end());
+  textChars.push_back('\0');
+}
+
+void DebugDraw::submit() {
+  RenderManager &renderManager = RenderManager::getInstance();
+  RenderManager::ViewTransform view = renderManager.getViewTransform();
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // The previous frame's buffers were consumed by its flush, reuse their capacity
+  submittedVertices.swap(vertices);
+  submittedIndices.swap(indices);
+  submittedChars.swap(textChars);
+  vertices.clear();
+  indices.clear();
+  textChars.clear();
+
+  if (view.enabled) {
+    for (SDL_Vertex &vertex : submittedVertices) {
+      vertex.position.x = (vertex.position.x - view.viewRect.x) * view.zoom;
+      vertex.position.y = (vertex.position.y - view.viewRect.y) * view.zoom;
+    }
+  }
+
+  renderManager.drawGeometry(RenderLayer::WORLD_DEBUG, submittedVertices.data(),
+                             static_cast<int>(submittedVertices.size()), submittedIndices.data(),
+                             static_cast<int>(submittedIndices.size()));
+
+  // Text goes through the queue, which applies the camera to world layers itself
+  for (const TextEntry &entry : texts) {
+    renderManager.drawDebugText(RenderLayer::WORLD_DEBUG, entry.position.x, entry.position.y,
+                                submittedChars.data() + entry.offset, entry.color);
+  }
+  texts.clear();
+
+  lastFrameVertexCount = submittedVertices.size();
+}
@@ -1,29 +1,41 @@
 #include "managers/DebugManager.h"
 
+#include <format>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 
+#include "AllocationTracker.h"
+#include "GameConfig.h"
 #include "Player.h"
 #include "managers/CollisionManager.h"
+#include "managers/DebugDraw.h"
+#include "managers/RenderManager.h"
+#include "utils/Profiler.h"
 
 DebugManager &DebugManager::getInstance() {
   static DebugManager instance;
   return instance;
 }
 
+void DebugManager::setDebugMode(bool enabled) {
+  debugMode = enabled;
+  DebugDraw::getInstance().setEnabled(enabled);
+}
+
 void DebugManager::initialize(SDL_Renderer *renderer) {
   this->renderer = renderer;
 }
 
-void DebugManager::render(SDL_Renderer *renderer) {
-  if (!debugMode || !renderer)
+void DebugManager::render() {
+  if (!debugMode)
     return;
 
-  SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+  RenderManager &renderManager = RenderManager::getInstance();
 
+  // debugLines stays untouched until the next clear(), which is after the queue is flushed
   for (const auto &line : debugLines) {
-    SDL_RenderDebugText(renderer, 5, line.yOffset, line.text.c_str());
+    renderManager.drawDebugText(RenderLayer::DEBUG_OVERLAY, line.x, line.yOffset, line.text.c_str(), {255, 255, 255, 255});
   }
 }
 
@@ -41,26 +53,15 @@ void DebugManager::debugPlayer(const Player *player, const std::string &playerNa
   auto pos = player->getPosition();
   addLine(playerName + " Pos: (" + std::to_string((int)pos.x) + ", " + std::to_string((int)pos.y) + ")");
 
-  int currentAnim = player->getCurrentAnimation();
-  std::string animName = "Unknown";
-  switch (currentAnim) {
-    case 0:
-      animName = "Idle";
-      break;
-    case 1:
-      animName = "Run";
-      break;
-    case 2:
-      animName = "Punch";
-      break;
-  }
+  int currentAnim = static_cast<int>(player->getCurrentAnimation());
+  const std::string &animName = player->getCurrentAnimationName();
 
-  addLine(playerName + " Animation: " + animName + " (" + std::to_string(currentAnim) + ")");
   addLine(playerName + " Animation: " + animName + " (" + std::to_string(currentAnim) + ")");
   addLine(playerName + " Is grounded: " + (player->isPlayerGrounded() ? "Yes" : "No"));
 
   bool isMoving = player->isMoving();
   addLine(playerName + " Moving: " + (isMoving ? "YES" : "NO"));
+  addLine(playerName + " Last special: " + getSpecialMoveName(player->getLastSpecial()));
 
   addLine("");
 }
@@ -81,6 +82,8 @@ void DebugManager::debugInputManager(const InputManager &inputManager) {
     p1Input += "JUMP ";
   if (inputManager.isActionPressed(PlayerId::Player1, PlayerAction::Punch))
     p1Input += "PUNCH ";
+  if (inputManager.isActionPressed(PlayerId::Player1, PlayerAction::Crouch))
+    p1Input += "CROUCH ";
   if (p1Input == "P1: ")
     p1Input += "NONE";
   addLine(p1Input);
@@ -95,10 +98,20 @@ void DebugManager::debugInputManager(const InputManager &inputManager) {
     p2Input += "JUMP ";
   if (inputManager.isActionPressed(PlayerId::Player2, PlayerAction::Punch))
     p2Input += "PUNCH ";
+  if (inputManager.isActionPressed(PlayerId::Player2, PlayerAction::Crouch))
+    p2Input += "CROUCH ";
   if (p2Input == "P2: ")
     p2Input += "NONE";
   addLine(p2Input);
 
+  if (inputManager.getLatencySampleCount() > 0) {
+    addLine(std::format("Input->present p50 {:.1f} p95 {:.1f} p99 {:.1f} ms",
+                        inputManager.getLatencyPercentileMs(50.0), inputManager.getLatencyPercentileMs(95.0),
+                        inputManager.getLatencyPercentileMs(99.0)));
+  } else {
+    addLine("Input->present: no samples");
+  }
+
   addLine("");
 }
 
@@ -160,7 +173,7 @@ void DebugManager::debugCollisionManager() {
           std::to_string((int)bounds.w) + ", " +
           std::to_string((int)bounds.h) + ")");
 
-  auto collisions = collisionManager.getLastFrameCollisions();
+  const auto &collisions = collisionManager.getLastFrameCollisions();
   addLine("Collisions this frame: " + std::to_string(collisions.size()));
 
   for (size_t i = 0; i < collisions.size() && i < 3; ++i) {  // Show max 3 collisions
@@ -189,55 +202,125 @@ void DebugManager::debugCollisionManager() {
   addLine("");
 }
 
-void DebugManager::renderCollisionBoxes(SDL_Renderer *renderer, const Player *player1, const Player *player2) {
-  if (!debugMode || !renderer)
+void DebugManager::debugProfiler() {
+  if (!debugMode)
+    return;
+
+#ifdef BLOODHORIZON_PROFILE
+  const float GRAPH_X = GameConfig::LOGICAL_WIDTH - 245.0f;  // room for a 30 character label
+  const float ROW_HEIGHT = 30.0f;
+  const float BAR_HEIGHT = 18.0f;
+  const float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+
+  RenderManager &renderManager = RenderManager::getInstance();
+  Profiler &profiler = Profiler::getInstance();
+
+  float rowY = 5.0f;
+  for (const Profiler::ZoneHistory &zone : profiler.getZones()) {
+    Profiler::ZoneStats stats = profiler.getStats(zone);
+
+    // Submitted with the other lines in render(), after the graph backgrounds
+    debugLines.push_back({std::format("{} {:.1f}/{:.1f}/{:.1f}", zone.name, stats.minMs, stats.avgMs, stats.maxMs),
+                          static_cast<int>(rowY), GRAPH_X});
+
+    SDL_FRect background{GRAPH_X, rowY + 10.0f, static_cast<float>(Profiler::HISTORY_FRAMES), BAR_HEIGHT};
+    renderManager.fillRect(RenderLayer::DEBUG_OVERLAY, background, {0, 0, 0, 160}, SDL_BLENDMODE_BLEND);
+
+    // Each zone is scaled to its own maximum, frames over the budget are red
+    float scale = stats.maxMs > 0.0 ? BAR_HEIGHT / static_cast<float>(stats.maxMs) : 0.0f;
+    for (size_t frame = 0; frame < Profiler::HISTORY_FRAMES; ++frame) {
+      float frameMs = profiler.getFrameMs(zone, frame);
+      float barHeight = frameMs * scale;
+      if (barHeight < 0.5f)
+        continue;
+
+      SDL_Color color = frameMs > FRAME_BUDGET_MS ? SDL_Color{255, 60, 60, 255} : SDL_Color{80, 220, 120, 255};
+      SDL_FRect bar{GRAPH_X + frame, background.y + BAR_HEIGHT - barHeight, 1.0f, barHeight};
+      renderManager.fillRect(RenderLayer::DEBUG_OVERLAY, bar, color, SDL_BLENDMODE_BLEND, 1.0f);
+    }
+
+    rowY += ROW_HEIGHT;
+  }
+
+  if (profiler.getDroppedSamples() > 0) {
+    addLine("Profiler dropped samples: " + std::to_string(profiler.getDroppedSamples()));
+  }
+#else
+  addLine("Profiler compiled out");
+#endif
+}
+
+void DebugManager::debugAllocations() {
+  if (!debugMode)
+    return;
+
+  if (!AllocationTracker::ENABLED) {
+    addLine("Allocation tracking compiled out");
+    addLine("");
+    return;
+  }
+
+  addLine("=== ALLOCATIONS ===");
+
+  // Includes the strings built for this overlay, which only exist while debug mode is on
+  const AllocationCounters &frame = AllocationTracker::getLastFrame();
+  addLine(std::format("Last frame: {} allocs, {:.1f} KB", frame.count, frame.bytes / 1024.0));
+  addLine("No-alloc violations: " + std::to_string(AllocationTracker::getViolationCount()));
+
+  for (const Profiler::ZoneHistory &zone : Profiler::getInstance().getZones()) {
+    if (zone.lastFrameAllocations.count == 0)
+      continue;
+    addLine(std::format("  {}: {} allocs, {} B", zone.name, zone.lastFrameAllocations.count,
+                        zone.lastFrameAllocations.bytes));
+  }
+
+  addLine("");
+}
+
+void DebugManager::renderCollisionBoxes(const Player *player1, const Player *player2) {
+  if (!debugMode)
     return;
 
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  DebugDraw &debugDraw = DebugDraw::getInstance();
+
+  auto drawBox = [&debugDraw](const SDL_FRect &box, Uint8 r, Uint8 g, Uint8 b, Uint8 fillAlpha) {
+    debugDraw.fillRect(box, {r, g, b, fillAlpha});
+    debugDraw.rect(box, {r, g, b, 255});
+  };
 
   if (player1) {
-    SDL_FRect hitbox1 = player1->getWorldHitbox();
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 100);
-    SDL_RenderFillRect(renderer, &hitbox1);
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    SDL_RenderRect(renderer, &hitbox1);
+    drawBox(player1->getWorldHitbox(), 0, 255, 0, 100);
 
-    if (player1->getCurrentAnimation() == 2) {
+    if (player1->getCurrentAnimation() == PlayerAnimState::TAKING_PUNCH) {
       SDL_FRect attackBox1 = player1->getAttackBox();
       if (attackBox1.w > 0 && attackBox1.h > 0) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 150);
-        SDL_RenderFillRect(renderer, &attackBox1);
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-        SDL_RenderRect(renderer, &attackBox1);
+        drawBox(attackBox1, 255, 255, 0, 150);
       }
     }
   }
 
   if (player2) {
-    SDL_FRect hitbox2 = player2->getWorldHitbox();
-    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 100);
-    SDL_RenderFillRect(renderer, &hitbox2);
-    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
-    SDL_RenderRect(renderer, &hitbox2);
+    drawBox(player2->getWorldHitbox(), 0, 0, 255, 100);
 
     // Render attack box if punching
-    if (player2->getCurrentAnimation() == 2) {
+    if (player2->getCurrentAnimation() == PlayerAnimState::TAKING_PUNCH) {
       SDL_FRect attackBox2 = player2->getAttackBox();
       if (attackBox2.w > 0 && attackBox2.h > 0) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 150);
-        SDL_RenderFillRect(renderer, &attackBox2);
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-        SDL_RenderRect(renderer, &attackBox2);
+        drawBox(attackBox2, 255, 255, 0, 150);
       }
     }
   }
 
+  const float NORMAL_LENGTH = 20.0f;
+
   CollisionManager &collisionManager = CollisionManager::getInstance();
-  SDL_FRect worldBounds = collisionManager.getWorldBounds();
-  SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-  SDL_RenderRect(renderer, &worldBounds);
+  for (const CollisionInfo &collision : collisionManager.getLastFrameCollisions()) {
+    debugDraw.circle(collision.contactPoint, 3.0f, {255, 255, 255, 255});
+    debugDraw.arrow(collision.contactPoint, collision.contactPoint + collision.normal * NORMAL_LENGTH,
+                    {255, 0, 255, 255});
+  }
 
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+  debugDraw.rect(collisionManager.getWorldBounds(), {255, 0, 0, 255});
 }
 
 void DebugManager::addLine(const std::string &text) {
@@ -1,7 +1,6 @@
 #include "managers/FontManager.h"
 
 #include <iostream>
-#include <vector>
 
 FontManager::FontManager() {
 }
@@ -10,8 +9,10 @@ FontManager::~FontManager() {
   cleanup();
 }
 
-bool FontManager::initialize() {
-  if (TTF_Init() == -1) {
+bool FontManager::initialize(const AssetArchive *archive) {
+  this->archive = archive;
+
+  if (!TTF_Init()) {
     std::cerr << "TTF_Init Error: " << SDL_GetError() << '\n';
     return false;
   }
@@ -19,16 +20,26 @@ bool FontManager::initialize() {
 }
 
 void FontManager::cleanup() {
+  if (atlasPreparation.valid()) {
+    atlasPreparation.wait();
+  }
+  atlas.reset();
+  atlasFailed = false;
+  loggedAtlasFailure = false;
   fonts.clear();
   TTF_Quit();
 }
 
-TTF_Font *FontManager::getFont(int size) const {
+TTF_Font *FontManager::getFont(int size) {
   auto it = fonts.find(size);
   if (it != fonts.end()) {
     return it->second.get();
   }
-  return nullptr;
+
+  if (defaultFontPath.empty() || !loadFont(defaultFontPath, size)) {
+    return nullptr;
+  }
+  return fonts[size].get();
 }
 
 bool FontManager::loadFont(const std::string &fontPath, int size) {
@@ -36,31 +47,8 @@ bool FontManager::loadFont(const std::string &fontPath, int size) {
     return true;
   }
 
-  TTF_Font *font = nullptr;
-
-  font = TTF_OpenFont(fontPath.c_str(), size);
-
+  TTF_Font *font = openFont(fontPath, static_cast<float>(size));
   if (font == nullptr) {
-    std::cerr << "TTF_OpenFont Error for " << fontPath << ": " << SDL_GetError() << '\n';
-
-    std::vector<std::string> fallbackFonts = {
-        "C:/Windows/Fonts/consola.ttf",  // Console font, similar to VGA
-        "C:/Windows/Fonts/cour.ttf",     // Courier New
-        "C:/Windows/Fonts/arial.ttf",    // Arial
-        "C:/Windows/Fonts/calibri.ttf",  // Calibri
-    };
-
-    for (const auto &fallback : fallbackFonts) {
-      font = TTF_OpenFont(fallback.c_str(), size);
-      if (font != nullptr) {
-        std::cout << "Using fallback font: " << fallback << " (size " << size << ")" << '\n';
-        break;
-      }
-    }
-  }
-
-  if (font == nullptr) {
-    std::cerr << "Failed to load any font for size " << size << '\n';
     std::cerr << "Note: .fon files are not supported. Please use .ttf or .otf fonts." << '\n';
     return false;
   }
@@ -69,3 +57,48 @@ bool FontManager::loadFont(const std::string &fontPath, int size) {
   std::cout << "Successfully loaded font at size " << size << '\n';
   return true;
 }
+
+void FontManager::prepareAtlas() {
+  if (atlas || atlasFailed || defaultFontPath.empty()) {
+    return;
+  }
+
+  // A separate instance, SDF rendering changes every glyph the font produces
+  unique_font font(openFont(defaultFontPath, SDF_RASTER_SIZE));
+  if (font && TTF_SetFontSDF(font.get(), true)) {
+    atlas = SDFFontAtlas::build(font.get(), SDF_RASTER_SIZE);
+  }
+
+  atlasFailed = !atlas;
+}
+
+const SDFFontAtlas *FontManager::getAtlas(SDL_Renderer *renderer) {
+  if (atlasPreparation.valid()) {
+    atlasPreparation.get();
+  }
+
+  if (!atlas && !atlasFailed) {
+    prepareAtlas();
+  }
+
+  if (atlas && !atlas->isUploaded() && !atlas->upload(renderer)) {
+    atlas.reset();
+    atlasFailed = true;
+  }
+
+  if (atlasFailed && !loggedAtlasFailure) {
+    std::cerr << "Failed to build SDF font atlas for " << defaultFontPath << ": " << SDL_GetError() << '\n';
+    loggedAtlasFailure = true;
+  }
+  return atlas.get();
+}
+
+TTF_Font *FontManager::openFont(const std::string &fontPath, float size) const {
+  SDL_IOStream *stream = archive ? archive->openIO(fontPath) : SDL_IOFromFile(fontPath.c_str(), "rb");
+  TTF_Font *font = TTF_OpenFontIO(stream, true, size);
+
+  if (font == nullptr) {
+    std::cerr << "TTF_OpenFont Error for " << fontPath << " (size " << size << "): " << SDL_GetError() << '\n';
+  }
+  return font;
+}
@@ -1,45 +1,101 @@
 #include "managers/InputManager.h"
 
-const std::unordered_map<SDL_Keycode, std::pair<PlayerId, PlayerAction>> InputManager::keyMappings = {
-    // Player 1 controls (WASD + Space)
-    {SDLK_A, {PlayerId::Player1, PlayerAction::MoveLeft}},
-    {SDLK_D, {PlayerId::Player1, PlayerAction::MoveRight}},
-    {SDLK_W, {PlayerId::Player1, PlayerAction::Jump}},
-    {SDLK_SPACE, {PlayerId::Player1, PlayerAction::Punch}},
-
-    // Player 2 controls (Arrow keys + Enter)
-    {SDLK_LEFT, {PlayerId::Player2, PlayerAction::MoveLeft}},
-    {SDLK_RIGHT, {PlayerId::Player2, PlayerAction::MoveRight}},
-    {SDLK_UP, {PlayerId::Player2, PlayerAction::Jump}},
-    {SDLK_RETURN, {PlayerId::Player2, PlayerAction::Punch}}};
+#include <algorithm>
+
+#include "managers/ResolutionManager.h"
+
+const std::array<InputManager::KeyBinding, SDL_SCANCODE_COUNT> InputManager::keyBindings = InputManager::buildKeyBindings();
+
+std::array<InputManager::KeyBinding, SDL_SCANCODE_COUNT> InputManager::buildKeyBindings() {
+  std::array<KeyBinding, SDL_SCANCODE_COUNT> bindings{};
+
+  auto bind = [&bindings](SDL_Scancode scancode, PlayerId playerId, PlayerAction action) {
+    bindings[scancode] = KeyBinding{.bound = true, .playerId = playerId, .action = action};
+  };
+
+  // Player 1 controls (WASD + Space)
+  bind(SDL_SCANCODE_A, PlayerId::Player1, PlayerAction::MoveLeft);
+  bind(SDL_SCANCODE_D, PlayerId::Player1, PlayerAction::MoveRight);
+  bind(SDL_SCANCODE_W, PlayerId::Player1, PlayerAction::Jump);
+  bind(SDL_SCANCODE_S, PlayerId::Player1, PlayerAction::Crouch);
+  bind(SDL_SCANCODE_SPACE, PlayerId::Player1, PlayerAction::Punch);
+
+  // Player 2 controls (Arrow keys + Enter)
+  bind(SDL_SCANCODE_LEFT, PlayerId::Player2, PlayerAction::MoveLeft);
+  bind(SDL_SCANCODE_RIGHT, PlayerId::Player2, PlayerAction::MoveRight);
+  bind(SDL_SCANCODE_UP, PlayerId::Player2, PlayerAction::Jump);
+  bind(SDL_SCANCODE_DOWN, PlayerId::Player2, PlayerAction::Crouch);
+  bind(SDL_SCANCODE_RETURN, PlayerId::Player2, PlayerAction::Punch);
+
+  return bindings;
+}
 
 void InputManager::initProcessSession() {
   primary = false;
 }
 
-void InputManager::processEvent(SDL_Event event) {
+void InputManager::processEvent(const SDL_Event &event) {
   if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
     if (event.button.button == SDL_BUTTON_LEFT)
       primary = true;
   }
 
-  if (event.type == SDL_EVENT_KEY_DOWN) {
-    auto it = keyMappings.find(event.key.key);
-    if (it != keyMappings.end()) {
-      PlayerId playerId = it->second.first;
-      PlayerAction action = it->second.second;
-      setActionState(playerId, action, true);
-    }
-  } else if (event.type == SDL_EVENT_KEY_UP) {
-    auto it = keyMappings.find(event.key.key);
-    if (it != keyMappings.end()) {
-      PlayerId playerId = it->second.first;
-      PlayerAction action = it->second.second;
-      setActionState(playerId, action, false);
-    }
+  if (event.type != SDL_EVENT_KEY_DOWN && event.type != SDL_EVENT_KEY_UP)
+    return;
+
+  // Held keys repeat, only real state changes are transitions
+  if (event.key.repeat || event.key.scancode >= SDL_SCANCODE_COUNT)
+    return;
+
+  const KeyBinding &binding = keyBindings[event.key.scancode];
+  if (!binding.bound)
+    return;
+
+  bool pressed = event.type == SDL_EVENT_KEY_DOWN;
+  if (isActionPressed(binding.playerId, binding.action) == pressed)
+    return;
+
+  setActionState(binding.playerId, binding.action, pressed);
+  pendingTransitions.push_back(InputTransition{
+      .playerId = binding.playerId, .action = binding.action, .pressed = pressed, .eventNs = event.key.timestamp});
+}
+
+void InputManager::markApplied(uint64_t tick) {
+  for (InputTransition &transition : pendingTransitions) {
+    if (transition.appliedTick == 0)
+      transition.appliedTick = tick;
   }
 }
 
+void InputManager::markPresented(Uint64 presentNs) {
+  presentedTransitions.clear();
+
+  for (InputTransition &transition : pendingTransitions) {
+    transition.presentedNs = presentNs;
+
+    double latencyMs = presentNs > transition.eventNs ? (presentNs - transition.eventNs) / 1'000'000.0 : 0.0;
+    latencySamplesMs[nextLatencySample] = latencyMs;
+    nextLatencySample = (nextLatencySample + 1) % LATENCY_SAMPLE_COUNT;
+    latencySampleCount = std::min(latencySampleCount + 1, LATENCY_SAMPLE_COUNT);
+
+    presentedTransitions.push_back(transition);
+  }
+
+  pendingTransitions.clear();
+}
+
+double InputManager::getLatencyPercentileMs(double percentile) const {
+  if (latencySampleCount == 0)
+    return 0.0;
+
+  std::array<double, LATENCY_SAMPLE_COUNT> sorted = latencySamplesMs;
+  auto end = sorted.begin() + latencySampleCount;
+
+  size_t rank = static_cast<size_t>(percentile / 100.0 * (latencySampleCount - 1) + 0.5);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, end);
+  return sorted[rank];
+}
+
 bool InputManager::isActionPressed(PlayerId playerId, PlayerAction action) const {
   int playerIndex = static_cast<int>(playerId);
   int actionIndex = static_cast<int>(action);
@@ -73,8 +129,21 @@ glm::vec2 InputManager::getCursorPosition(SDL_Renderer *renderer) const {
 
   SDL_GetMouseState(&mouseX, &mouseY);
 
-  float logicalX, logicalY;
-  SDL_RenderCoordinatesFromWindow(renderer, mouseX, mouseY, &logicalX, &logicalY);
+  float outputX, outputY;
+  SDL_RenderCoordinatesFromWindow(renderer, mouseX, mouseY, &outputX, &outputY);
+
+  // With SDL's logical presentation the coordinates are already logical
+  ResolutionManager &resolutionManager = ResolutionManager::getInstance();
+  if (!resolutionManager.usesOffscreenPresentation()) {
+    return glm::vec2(outputX, outputY);
+  }
+
+  // Undo the letterboxed upscale of the logical render target
+  int outputWidth, outputHeight;
+  SDL_GetRenderOutputSize(renderer, &outputWidth, &outputHeight);
+
+  SDL_FRect viewport = resolutionManager.getPresentationRect(outputWidth, outputHeight);
+  float scale = viewport.w / resolutionManager.getLogicalResolution().width;
 
-  return glm::vec2(logicalX, logicalY);
+  return glm::vec2((outputX - viewport.x) / scale, (outputY - viewport.y) / scale);
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "managers/LiveStatePublisher.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+LiveStatePublisher::~LiveStatePublisher() {
+  close();
+}
+
+bool LiveStatePublisher::open(const std::string &segmentName) {
+  close();
+
+  if (!mapSegment(segmentName))
+    return false;
+
+  // Readers ignore the segment until the header matches, the sequence continues from a previous run
+  LiveStateFormat::SegmentHeader &header = segment->header;
+  header.version = LiveStateFormat::VERSION;
+  header.snapshotSize = sizeof(LiveStateFormat::Snapshot);
+  if (header.sequence.load(std::memory_order_relaxed) & 1) {
+    header.sequence.fetch_add(1, std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header.magic, LiveStateFormat::MAGIC, sizeof(LiveStateFormat::MAGIC));
+
+  std::cout << "Publishing live state to shared memory " << name << '\n';
+  return true;
+}
+
+void LiveStatePublisher::close() {
+  if (!segment)
+    return;
+
+  unmapSegment();
+  segment = nullptr;
+  name.clear();
+}
+
+#ifdef _WIN32
+
+bool LiveStatePublisher::mapSegment(const std::string &segmentName) {
+  HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+                                     sizeof(LiveStateFormat::Segment), segmentName.c_str());
+  if (!mapping) {
+    std::cerr << "Failed to create live state mapping " << segmentName << '\n';
+    return false;
+  }
+
+  void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(LiveStateFormat::Segment));
+  if (!view) {
+    std::cerr << "Failed to map live state mapping " << segmentName << '\n';
+    CloseHandle(mapping);
+    return false;
+  }
+
+  mappingHandle = mapping;
+  segment = static_cast<LiveStateFormat::Segment *>(view);
+  name = segmentName;
+  return true;
+}
+
+void LiveStatePublisher::unmapSegment() {
+  UnmapViewOfFile(segment);
+  CloseHandle(mappingHandle);
+  mappingHandle = nullptr;
+}
+
+#else
+
+bool LiveStatePublisher::mapSegment(const std::string &segmentName) {
+  std::string shmName = "/" + segmentName;
+  int fd = shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0644);
+  if (fd < 0) {
+    std::cerr << "Failed to create shared memory " << shmName << ": " << std::strerror(errno) << '\n';
+    return false;
+  }
+
+  if (ftruncate(fd, sizeof(LiveStateFormat::Segment)) != 0) {
+    std::cerr << "Failed to size shared memory " << shmName << ": " << std::strerror(errno) << '\n';
+    ::close(fd);
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  void *view = mmap(nullptr, sizeof(LiveStateFormat::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (view == MAP_FAILED) {
+    std::cerr << "Failed to map shared memory " << shmName << ": " << std::strerror(errno) << '\n';
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  segment = static_cast<LiveStateFormat::Segment *>(view);
+  name = shmName;
+  return true;
+}
+
+void LiveStatePublisher::unmapSegment() {
+  munmap(segment, sizeof(LiveStateFormat::Segment));
+  shm_unlink(name.c_str());
+}
+
+#endif
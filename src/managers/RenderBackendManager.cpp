@@ -0,0 +1,232 @@
+#include "managers/RenderBackendManager.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "utils/SDLDeleter.h"
+
+namespace {
+
+const char *CONFIG_FILE_NAME = "renderer.cfg";
+const char *CONFIG_KEY = "renderer=";
+
+double framesPerSecond(Uint64 elapsedCounter, int frames) {
+  if (elapsedCounter == 0)
+    return 0.0;
+  double seconds = static_cast<double>(elapsedCounter) / SDL_GetPerformanceFrequency();
+  return frames / seconds;
+}
+
+unique_texture createBenchmarkSprite(SDL_Renderer *renderer) {
+  unique_surface surface(SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_RGBA8888));
+  if (!surface)
+    return nullptr;
+
+  SDL_FillSurfaceRect(surface.get(), nullptr, SDL_MapSurfaceRGBA(surface.get(), 0, 0, 0, 0));
+  SDL_Rect body = {8, 4, 16, 28};
+  SDL_FillSurfaceRect(surface.get(), &body, SDL_MapSurfaceRGBA(surface.get(), 200, 40, 40, 255));
+  SDL_Rect head = {11, 0, 10, 8};
+  SDL_FillSurfaceRect(surface.get(), &head, SDL_MapSurfaceRGBA(surface.get(), 230, 190, 170, 255));
+
+  unique_texture texture(SDL_CreateTextureFromSurface(renderer, surface.get()));
+  if (texture) {
+    SDL_SetTextureScaleMode(texture.get(), SDL_SCALEMODE_NEAREST);
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+  }
+  return texture;
+}
+
+}  // namespace
+
+double BackendBenchmarkResult::score() const {
+  if (!created || spriteFramesPerSecond <= 0.0 || textFramesPerSecond <= 0.0)
+    return 0.0;
+  return 1.0 / (1.0 / spriteFramesPerSecond + 1.0 / textFramesPerSecond);
+}
+
+RenderBackendManager &RenderBackendManager::getInstance() {
+  static RenderBackendManager instance;
+  return instance;
+}
+
+std::vector<std::string> RenderBackendManager::getAvailableDrivers() const {
+  std::vector<std::string> drivers;
+
+  int count = SDL_GetNumRenderDrivers();
+  for (int i = 0; i < count; ++i) {
+    const char *name = SDL_GetRenderDriver(i);
+    if (name) {
+      drivers.emplace_back(name);
+    }
+  }
+
+  return drivers;
+}
+
+bool RenderBackendManager::isDriverAvailable(const std::string &driverName) const {
+  auto drivers = getAvailableDrivers();
+  return std::find(drivers.begin(), drivers.end(), driverName) != drivers.end();
+}
+
+std::string RenderBackendManager::selectBackend(SDL_Window *window, const LaunchOptions &options) {
+  if (!options.rendererName.empty()) {
+    if (isDriverAvailable(options.rendererName)) {
+      return options.rendererName;
+    }
+    std::cerr << "Render driver '" << options.rendererName << "' is not available, using default" << '\n';
+    return "";
+  }
+
+  if (options.benchmarkRenderers) {
+    auto results = benchmarkAll(window);
+
+    auto best = std::max_element(results.begin(), results.end(),
+                                 [](const BackendBenchmarkResult &a, const BackendBenchmarkResult &b) {
+                                   return a.score() < b.score();
+                                 });
+
+    if (best != results.end() && best->score() > 0.0) {
+      std::cout << "Fastest render driver: " << best->driverName << '\n';
+      saveCachedBackend(best->driverName);
+      return best->driverName;
+    }
+    return "";
+  }
+
+  std::string cached = loadCachedBackend();
+  if (!cached.empty() && isDriverAvailable(cached)) {
+    return cached;
+  }
+
+  return "";
+}
+
+std::vector<BackendBenchmarkResult> RenderBackendManager::benchmarkAll(SDL_Window *window) const {
+  std::vector<BackendBenchmarkResult> results;
+
+  std::cout << std::left << std::setw(12) << "Driver" << std::right << std::setw(14) << "Sprites FPS"
+            << std::setw(12) << "Text FPS" << std::setw(12) << "Score" << '\n';
+
+  for (const auto &driver : getAvailableDrivers()) {
+    BackendBenchmarkResult result = benchmarkDriver(window, driver);
+
+    std::cout << std::left << std::setw(12) << result.driverName << std::right << std::fixed << std::setprecision(1);
+    if (result.created) {
+      std::cout << std::setw(14) << result.spriteFramesPerSecond << std::setw(12) << result.textFramesPerSecond
+                << std::setw(12) << result.score() << '\n';
+    } else {
+      std::cout << std::setw(14) << "-" << std::setw(12) << "-" << std::setw(12) << "failed" << '\n';
+    }
+
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+BackendBenchmarkResult RenderBackendManager::benchmarkDriver(SDL_Window *window, const std::string &driverName) const {
+  BackendBenchmarkResult result{driverName, false, 0.0, 0.0};
+
+  unique_renderer renderer(SDL_CreateRenderer(window, driverName.c_str()));
+  if (!renderer) {
+    return result;
+  }
+  result.created = true;
+
+  // Measure raw throughput, not the display refresh rate
+  SDL_SetRenderVSync(renderer.get(), 0);
+
+  unique_texture sprite = createBenchmarkSprite(renderer.get());
+  if (!sprite) {
+    result.created = false;
+    return result;
+  }
+
+  int outputWidth = 0, outputHeight = 0;
+  SDL_GetRenderOutputSize(renderer.get(), &outputWidth, &outputHeight);
+  outputWidth = std::max(outputWidth, 64);
+  outputHeight = std::max(outputHeight, 64);
+
+  auto drawSprites = [&](int frame) {
+    for (int i = 0; i < BENCHMARK_SPRITES; ++i) {
+      SDL_FRect dst = {static_cast<float>((i * 37 + frame * 3) % (outputWidth - 32)),
+                       static_cast<float>((i * 53 + frame) % (outputHeight - 32)), 32, 32};
+      SDL_RenderTexture(renderer.get(), sprite.get(), nullptr, &dst);
+    }
+  };
+
+  auto drawText = [&](int frame) {
+    SDL_SetRenderDrawColor(renderer.get(), 255, 255, 255, 255);
+    for (int i = 0; i < BENCHMARK_TEXT_LINES; ++i) {
+      float x = static_cast<float>((i * 29 + frame) % (outputWidth / 2));
+      float y = static_cast<float>((i * 11) % (outputHeight - 8));
+      SDL_RenderDebugText(renderer.get(), x, y, "BLOOD HORIZON 0123456789");
+    }
+  };
+
+  auto runPass = [&](auto &&draw) {
+    // A few warm-up frames so driver-side caches and texture uploads are excluded
+    for (int frame = 0; frame < 5; ++frame) {
+      SDL_SetRenderDrawColor(renderer.get(), 20, 10, 30, 255);
+      SDL_RenderClear(renderer.get());
+      draw(frame);
+      SDL_RenderPresent(renderer.get());
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame) {
+      SDL_SetRenderDrawColor(renderer.get(), 20, 10, 30, 255);
+      SDL_RenderClear(renderer.get());
+      draw(frame);
+      SDL_RenderPresent(renderer.get());
+    }
+    return framesPerSecond(SDL_GetPerformanceCounter() - start, BENCHMARK_FRAMES);
+  };
+
+  result.spriteFramesPerSecond = runPass(drawSprites);
+  result.textFramesPerSecond = runPass(drawText);
+
+  return result;
+}
+
+std::string RenderBackendManager::getConfigPath() const {
+  char *prefPath = SDL_GetPrefPath("BloodHorizon", "BloodHorizon");
+  if (!prefPath) {
+    return CONFIG_FILE_NAME;
+  }
+
+  std::string path = std::string(prefPath) + CONFIG_FILE_NAME;
+  SDL_free(prefPath);
+  return path;
+}
+
+std::string RenderBackendManager::loadCachedBackend() const {
+  std::ifstream file(getConfigPath());
+  if (!file) {
+    return "";
+  }
+
+  std::string line;
+  const std::string key = CONFIG_KEY;
+  while (std::getline(file, line)) {
+    if (line.rfind(key, 0) == 0) {
+      return line.substr(key.size());
+    }
+  }
+
+  return "";
+}
+
+bool RenderBackendManager::saveCachedBackend(const std::string &driverName) const {
+  std::string path = getConfigPath();
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    std::cerr << "Failed to write renderer config: " << path << '\n';
+    return false;
+  }
+
+  file << CONFIG_KEY << driverName << '\n';
+  return true;
+}
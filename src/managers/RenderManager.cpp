@@ -0,0 +1,477 @@
+#include "managers/RenderManager.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "Camera.h"
+
+namespace {
+
+uint64_t blendModeIndex(SDL_BlendMode blendMode) {
+  switch (blendMode) {
+    case SDL_BLENDMODE_NONE:
+      return 0;
+    case SDL_BLENDMODE_BLEND:
+      return 1;
+    case SDL_BLENDMODE_ADD:
+      return 2;
+    case SDL_BLENDMODE_MOD:
+      return 3;
+    case SDL_BLENDMODE_MUL:
+      return 4;
+    default:
+      return 15;
+  }
+}
+
+// Maps a float onto an unsigned integer with the same ordering (negative values included)
+uint32_t orderedDepth(float depth) {
+  uint32_t bits;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+bool sameColor(const SDL_Color &a, const SDL_Color &b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+}  // namespace
+
+RenderManager &RenderManager::getInstance() {
+  static RenderManager instance;
+  return instance;
+}
+
+void RenderManager::initialize(SDL_Renderer *renderer) {
+  this->renderer = renderer;
+
+  if (renderer) {
+    SDL_PropertiesID properties = SDL_GetRendererProperties(renderer);
+    textureWrapping = SDL_GetBooleanProperty(properties, SDL_PROP_RENDERER_TEXTURE_WRAPPING_BOOLEAN, false);
+  }
+
+  commands.reserve(1024);
+  sortEntries.reserve(1024);
+  sortScratch.reserve(1024);
+  rectBatch.reserve(256);
+}
+
+void RenderManager::cleanup() {
+  std::lock_guard<std::mutex> lock(queueMutex);
+
+  commands.clear();
+  sortEntries.clear();
+  textureIds.clear();
+  nextTextureId = 1;
+  renderer = nullptr;
+}
+
+uint64_t RenderManager::makeSortKey(RenderLayer layer, SDL_BlendMode blendMode, uint32_t textureId, float depth) {
+  if (isDepthSortedLayer(layer)) {
+    return (static_cast<uint64_t>(layer) << 56) |
+           (static_cast<uint64_t>(orderedDepth(depth)) << 24) |
+           (blendModeIndex(blendMode) << 20) |
+           (textureId & TEXTURE_ID_MASK);
+  }
+
+  return (static_cast<uint64_t>(layer) << 56) |
+         (blendModeIndex(blendMode) << 52) |
+         (static_cast<uint64_t>(textureId & TEXTURE_ID_MASK) << 32) |
+         orderedDepth(depth);
+}
+
+uint32_t RenderManager::getTextureId(SDL_Texture *texture) {
+  if (!texture)
+    return 0;
+
+  auto it = textureIds.find(texture);
+  if (it != textureIds.end()) {
+    return it->second;
+  }
+
+  uint32_t id = nextTextureId;
+  nextTextureId = nextTextureId == TEXTURE_ID_MASK ? 1 : nextTextureId + 1;
+  textureIds[texture] = id;
+  return id;
+}
+
+void RenderManager::setCamera(const Camera &camera) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  view = {camera.getViewRect(), camera.getZoom(), true};
+}
+
+void RenderManager::resetCamera() {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  view.enabled = false;
+}
+
+RenderManager::ViewTransform RenderManager::getViewTransform() {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  return view;
+}
+
+bool RenderManager::toScreenSpace(RenderCommand &command) const {
+  // Transformed by the submitter
+  if (command.type == RenderCommandType::GEOMETRY)
+    return true;
+
+  if (command.type == RenderCommandType::DEBUG_TEXT) {
+    command.dst.x = (command.dst.x - view.viewRect.x) * view.zoom;
+    command.dst.y = (command.dst.y - view.viewRect.y) * view.zoom;
+    return true;
+  }
+
+  const SDL_FRect &dst = command.dst;
+  const SDL_FRect &viewRect = view.viewRect;
+  if (dst.x >= viewRect.x + viewRect.w || dst.x + dst.w <= viewRect.x ||
+      dst.y >= viewRect.y + viewRect.h || dst.y + dst.h <= viewRect.y) {
+    return false;
+  }
+
+  command.dst = SDL_FRect{(dst.x - viewRect.x) * view.zoom, (dst.y - viewRect.y) * view.zoom,
+                          dst.w * view.zoom, dst.h * view.zoom};
+  return true;
+}
+
+void RenderManager::enqueue(const RenderCommand &command, RenderLayer layer, float depth) {
+  if (view.enabled && isWorldLayer(layer)) {
+    RenderCommand transformed = command;
+    if (!toScreenSpace(transformed)) {
+      culledCount++;
+      return;
+    }
+    uint64_t key = makeSortKey(layer, transformed.blendMode, getTextureId(transformed.texture), depth);
+    sortEntries.push_back({key, static_cast<uint32_t>(commands.size())});
+    commands.push_back(transformed);
+    return;
+  }
+
+  uint64_t key = makeSortKey(layer, command.blendMode, getTextureId(command.texture), depth);
+  sortEntries.push_back({key, static_cast<uint32_t>(commands.size())});
+  commands.push_back(command);
+}
+
+void RenderManager::submit(const RenderCommand &command, RenderLayer layer, float depth) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  enqueue(command, layer, depth);
+}
+
+void RenderManager::submitBatch(const std::vector<RenderCommand> &batch, RenderLayer layer, float depth) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+
+  for (const auto &command : batch) {
+    enqueue(command, layer, depth);
+  }
+}
+
+void RenderManager::drawTexture(RenderLayer layer, SDL_Texture *texture, const SDL_FRect *src, const SDL_FRect &dst,
+                                float depth, SDL_FlipMode flip, SDL_Color color) {
+  if (!texture)
+    return;
+
+  RenderCommand command{};
+  command.type = RenderCommandType::TEXTURE;
+  command.blendMode = SDL_BLENDMODE_BLEND;
+  command.texture = texture;
+  command.hasSrc = src != nullptr;
+  if (src) {
+    command.src = *src;
+  }
+  command.dst = dst;
+  command.color = color;
+  command.flip = flip;
+
+  submit(command, layer, depth);
+}
+
+void RenderManager::drawTextureWrapped(RenderLayer layer, SDL_Texture *texture, float offsetX, const SDL_FRect &dst) {
+  if (!texture)
+    return;
+
+  RenderCommand command{};
+  command.type = RenderCommandType::TEXTURE_WRAPPED;
+  command.blendMode = SDL_BLENDMODE_BLEND;
+  command.texture = texture;
+  command.src = {offsetX, 0, 0, 0};
+  command.dst = dst;
+  command.color = {255, 255, 255, 255};
+  command.flip = SDL_FLIP_NONE;
+
+  submit(command, layer);
+}
+
+void RenderManager::fillRect(RenderLayer layer, const SDL_FRect &rect, SDL_Color color,
+                             SDL_BlendMode blendMode, float depth) {
+  RenderCommand command{};
+  command.type = RenderCommandType::FILL_RECT;
+  command.blendMode = blendMode;
+  command.dst = rect;
+  command.color = color;
+
+  submit(command, layer, depth);
+}
+
+void RenderManager::drawRect(RenderLayer layer, const SDL_FRect &rect, SDL_Color color,
+                             SDL_BlendMode blendMode, float depth) {
+  RenderCommand command{};
+  command.type = RenderCommandType::RECT;
+  command.blendMode = blendMode;
+  command.dst = rect;
+  command.color = color;
+
+  submit(command, layer, depth);
+}
+
+void RenderManager::drawDebugText(RenderLayer layer, float x, float y, const char *text, SDL_Color color) {
+  RenderCommand command{};
+  command.type = RenderCommandType::DEBUG_TEXT;
+  command.blendMode = SDL_BLENDMODE_BLEND;
+  command.dst = {x, y, 0, 0};
+  command.color = color;
+  command.text = text;
+
+  submit(command, layer);
+}
+
+void RenderManager::drawGeometry(RenderLayer layer, const SDL_Vertex *vertices, int vertexCount, const int *indices,
+                                 int indexCount, SDL_BlendMode blendMode) {
+  if (vertexCount == 0)
+    return;
+
+  RenderCommand command{};
+  command.type = RenderCommandType::GEOMETRY;
+  command.blendMode = blendMode;
+  command.vertices = vertices;
+  command.indices = indices;
+  command.vertexCount = vertexCount;
+  command.indexCount = indexCount;
+
+  submit(command, layer);
+}
+
+void RenderManager::flush() {
+  std::lock_guard<std::mutex> lock(queueMutex);
+
+  if (renderer) {
+    radixSort();
+    execute();
+  }
+
+  lastFrameCommandCount = commands.size();
+  lastFrameCulledCount = culledCount;
+  culledCount = 0;
+  commands.clear();
+  sortEntries.clear();
+}
+
+// LSD radix sort over 8-bit digits. Passes where every key shares the same digit are skipped,
+// which is the common case for the upper texture id bits and most of the depth bits.
+void RenderManager::radixSort() {
+  const size_t count = sortEntries.size();
+  if (count < 2)
+    return;
+
+  sortScratch.resize(count);
+
+  SortEntry *source = sortEntries.data();
+  SortEntry *destination = sortScratch.data();
+
+  for (int shift = 0; shift < 64; shift += 8) {
+    std::array<size_t, 256> histogram{};
+    for (size_t i = 0; i < count; ++i) {
+      histogram[(source[i].key >> shift) & 0xFF]++;
+    }
+
+    if (histogram[(source[0].key >> shift) & 0xFF] == count)
+      continue;
+
+    size_t offset = 0;
+    for (auto &bucket : histogram) {
+      size_t bucketSize = bucket;
+      bucket = offset;
+      offset += bucketSize;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+    }
+
+    std::swap(source, destination);
+  }
+
+  if (source != sortEntries.data()) {
+    std::memcpy(sortEntries.data(), source, count * sizeof(SortEntry));
+  }
+}
+
+void RenderManager::execute() {
+  size_t stateChanges = 0;
+
+  SDL_BlendMode currentDrawBlend = SDL_BLENDMODE_INVALID;
+  SDL_Color currentDrawColor = {0, 0, 0, 0};
+  bool drawColorKnown = false;
+
+  SDL_Texture *currentTexture = nullptr;
+  SDL_BlendMode currentTextureBlend = SDL_BLENDMODE_INVALID;
+  SDL_Color currentTextureColor = {255, 255, 255, 255};
+
+  auto setDrawState = [&](const RenderCommand &command) {
+    if (command.blendMode != currentDrawBlend) {
+      SDL_SetRenderDrawBlendMode(renderer, command.blendMode);
+      currentDrawBlend = command.blendMode;
+      stateChanges++;
+    }
+    if (!drawColorKnown || !sameColor(command.color, currentDrawColor)) {
+      SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+      currentDrawColor = command.color;
+      drawColorKnown = true;
+      stateChanges++;
+    }
+  };
+
+  const size_t count = sortEntries.size();
+  size_t i = 0;
+  while (i < count) {
+    const RenderCommand &command = commands[sortEntries[i].index];
+
+    switch (command.type) {
+      case RenderCommandType::TEXTURE: {
+        if (command.texture != currentTexture || command.blendMode != currentTextureBlend) {
+          SDL_SetTextureBlendMode(command.texture, command.blendMode);
+          currentTexture = command.texture;
+          currentTextureBlend = command.blendMode;
+          stateChanges++;
+
+          // The colour mod is per texture, so it is unknown after switching
+          SDL_GetTextureColorMod(command.texture, &currentTextureColor.r, &currentTextureColor.g, &currentTextureColor.b);
+          SDL_GetTextureAlphaMod(command.texture, &currentTextureColor.a);
+        }
+        if (!sameColor(command.color, currentTextureColor)) {
+          SDL_SetTextureColorMod(command.texture, command.color.r, command.color.g, command.color.b);
+          SDL_SetTextureAlphaMod(command.texture, command.color.a);
+          currentTextureColor = command.color;
+          stateChanges++;
+        }
+
+        const SDL_FRect *src = command.hasSrc ? &command.src : nullptr;
+        if (command.flip == SDL_FLIP_NONE) {
+          SDL_RenderTexture(renderer, command.texture, src, &command.dst);
+        } else {
+          SDL_RenderTextureRotated(renderer, command.texture, src, &command.dst, 0, nullptr, command.flip);
+        }
+        i++;
+        break;
+      }
+      case RenderCommandType::TEXTURE_WRAPPED: {
+        if (command.texture != currentTexture || command.blendMode != currentTextureBlend) {
+          SDL_SetTextureBlendMode(command.texture, command.blendMode);
+          currentTexture = command.texture;
+          currentTextureBlend = command.blendMode;
+          stateChanges++;
+
+          SDL_GetTextureColorMod(command.texture, &currentTextureColor.r, &currentTextureColor.g, &currentTextureColor.b);
+          SDL_GetTextureAlphaMod(command.texture, &currentTextureColor.a);
+        }
+
+        renderWrapped(command);
+        i++;
+        break;
+      }
+      case RenderCommandType::FILL_RECT:
+      case RenderCommandType::RECT: {
+        setDrawState(command);
+
+        // Consecutive rects sharing colour and blend mode go out in a single call
+        rectBatch.clear();
+        size_t j = i;
+        while (j < count) {
+          const RenderCommand &next = commands[sortEntries[j].index];
+          if (next.type != command.type || next.blendMode != command.blendMode || !sameColor(next.color, command.color))
+            break;
+          rectBatch.push_back(next.dst);
+          j++;
+        }
+
+        int rectCount = static_cast<int>(rectBatch.size());
+        if (command.type == RenderCommandType::FILL_RECT) {
+          SDL_RenderFillRects(renderer, rectBatch.data(), rectCount);
+        } else {
+          SDL_RenderRects(renderer, rectBatch.data(), rectCount);
+        }
+        i = j;
+        break;
+      }
+      case RenderCommandType::DEBUG_TEXT: {
+        setDrawState(command);
+        if (command.text) {
+          SDL_RenderDebugText(renderer, command.dst.x, command.dst.y, command.text);
+        }
+        i++;
+        break;
+      }
+      case RenderCommandType::GEOMETRY: {
+        // Untextured geometry takes its blend mode from the draw state
+        if (command.blendMode != currentDrawBlend) {
+          SDL_SetRenderDrawBlendMode(renderer, command.blendMode);
+          currentDrawBlend = command.blendMode;
+          stateChanges++;
+        }
+        SDL_RenderGeometry(renderer, nullptr, command.vertices, command.vertexCount, command.indices, command.indexCount);
+        i++;
+        break;
+      }
+    }
+  }
+
+  // Leave the renderer in its default blend state for code outside the queue
+  if (currentDrawBlend != SDL_BLENDMODE_NONE && currentDrawBlend != SDL_BLENDMODE_INVALID) {
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+  }
+
+  lastFrameStateChanges = stateChanges;
+}
+
+void RenderManager::renderWrapped(const RenderCommand &command) {
+  float textureWidth, textureHeight;
+  SDL_GetTextureSize(command.texture, &textureWidth, &textureHeight);
+  if (textureWidth <= 0)
+    return;
+
+  float offset = std::fmod(command.src.x, textureWidth);
+  if (offset < 0)
+    offset += textureWidth;
+
+  const SDL_FRect &dst = command.dst;
+
+  if (textureWrapping) {
+    // One quad, UVs past 1.0 wrap around on the GPU
+    float u0 = offset / textureWidth;
+    float u1 = u0 + 1.0f;
+    SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+
+    const SDL_Vertex vertices[4] = {
+        {{dst.x, dst.y}, white, {u0, 0.0f}},
+        {{dst.x + dst.w, dst.y}, white, {u1, 0.0f}},
+        {{dst.x + dst.w, dst.y + dst.h}, white, {u1, 1.0f}},
+        {{dst.x, dst.y + dst.h}, white, {u0, 1.0f}}};
+    static const int indices[6] = {0, 1, 2, 0, 2, 3};
+
+    SDL_RenderGeometry(renderer, command.texture, vertices, 4, indices, 6);
+    return;
+  }
+
+  // No wrap addressing on this backend, split the quad at the seam
+  float scale = dst.w / textureWidth;
+  float firstWidth = textureWidth - offset;
+
+  SDL_FRect firstSrc = {offset, 0, firstWidth, textureHeight};
+  SDL_FRect firstDst = {dst.x, dst.y, firstWidth * scale, dst.h};
+  SDL_RenderTexture(renderer, command.texture, &firstSrc, &firstDst);
+
+  if (offset > 0) {
+    SDL_FRect secondSrc = {0, 0, offset, textureHeight};
+    SDL_FRect secondDst = {dst.x + firstDst.w, dst.y, offset * scale, dst.h};
+    SDL_RenderTexture(renderer, command.texture, &secondSrc, &secondDst);
+  }
+}
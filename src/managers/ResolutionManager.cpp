@@ -60,6 +60,30 @@ Resolution ResolutionManager::getClosestPixelPerfectResolution(int width, int he
   return Resolution(logicalResolution.width * scale, logicalResolution.height * scale);
 }
 
+int ResolutionManager::getIntegerScale(int outputWidth, int outputHeight) const {
+  int scale = std::min(outputWidth / logicalResolution.width, outputHeight / logicalResolution.height);
+  return std::max(scale, 1);
+}
+
+SDL_FRect ResolutionManager::getPresentationRect(int outputWidth, int outputHeight) const {
+  float scale = static_cast<float>(getIntegerScale(outputWidth, outputHeight));
+
+  if (outputWidth < logicalResolution.width || outputHeight < logicalResolution.height) {
+    scale = std::min(static_cast<float>(outputWidth) / logicalResolution.width,
+                     static_cast<float>(outputHeight) / logicalResolution.height);
+  }
+
+  float width = logicalResolution.width * scale;
+  float height = logicalResolution.height * scale;
+
+  // Whole-pixel offsets keep the upscaled texels aligned to the output grid
+  return SDL_FRect{
+      static_cast<float>(static_cast<int>((outputWidth - width) / 2.0f)),
+      static_cast<float>(static_cast<int>((outputHeight - height) / 2.0f)),
+      width,
+      height};
+}
+
 void ResolutionManager::generateAvailableResolutions() {
   availableResolutions.clear();
 
@@ -1,111 +1,359 @@
 #include "managers/ResourceManager.h"
 
 #include <SDL3_image/SDL_image.h>
+#include <lz4.h>
 
-bool ResourceManager::initialize(SDL_Renderer *renderer) {
+#include <cstring>
+#include <future>
+
+#include "AssetManifest.h"
+#include "utils/CookedTextureFormat.h"
+#include "utils/Profiler.h"
+
+bool ResourceManager::initialize() {
   if (initialized) {
     return true;
   }
 
-  this->renderer = renderer;
+  // Packed assets are optional, anything missing from the archive is read from disk
+  if (archive.open("resources.pak")) {
+    std::cout << "Using asset archive with " << archive.getAssetCount() << " assets" << '\n';
+  }
+
+  decodePool = std::make_unique<ThreadPool>();
+
+  if (hotReload) {
+    assetWatcher.start("resources", [this](const std::string &path) {
+      std::lock_guard<std::mutex> lock(changedMutex);
+      changedPaths.push_back(path);
+    });
+  }
+
+  // Initialize font manager, fonts are opened on first use
+  fontManager.initialize(&archive);
+  fontManager.setDefaultFont(std::string(Assets::fonts::vgasyse.getPath()));
 
-  // Initialize font manager
-  fontManager.initialize();
-  fontManager.loadFont("resources/fonts/vgasyse.ttf", 12);
-  fontManager.loadFont("resources/fonts/vgasyse.ttf", 24);
-  fontManager.loadFont("resources/fonts/vgasyse.ttf", 32);
+  // Rasterise the SDF atlas in the background, only the upload needs the renderer
+  auto atlasTask = std::make_shared<std::packaged_task<void()>>([this]() { fontManager.prepareAtlas(); });
+  fontManager.setAtlasPreparation(atlasTask->get_future());
+  decodePool->enqueue([atlasTask]() { (*atlasTask)(); });
 
   // Initialize animations
-  animations[AnimationType::PLAYER1_IDLE] = Animation(8, 12);         // 8 frames, 12 game frames each = 96 game frames total (1.6s)
-  animations[AnimationType::PLAYER1_RUN] = Animation(6, 7);           // 6 frames, 7 game frames each = 42 game frames total (0.7s)
-  animations[AnimationType::PLAYER1_TAKING_PUNCH] = Animation(6, 7);  // 6 frames, 7 game frames each = 42 game frames total (0.7s)
+  const float idleFrame = 12.0f / 60.0f;  // 8 frames, 1.6s
+  const float runFrame = 7.0f / 60.0f;    // 6 frames, 0.7s
+
+  animationClips[AnimationType::PLAYER1_IDLE] = AnimationClip(8, idleFrame, LoopMode::LOOP);
+  animationClips[AnimationType::PLAYER1_RUN] = AnimationClip(6, runFrame, LoopMode::LOOP);
+  animationClips[AnimationType::PLAYER1_TAKING_PUNCH] = AnimationClip(6, runFrame, LoopMode::ONCE);
 
-  animations[AnimationType::PLAYER2_IDLE] = Animation(8, 12);
-  animations[AnimationType::PLAYER2_RUN] = Animation(6, 7);
-  animations[AnimationType::PLAYER2_TAKING_PUNCH] = Animation(6, 7);
+  animationClips[AnimationType::PLAYER2_IDLE] = AnimationClip(8, idleFrame, LoopMode::LOOP);
+  animationClips[AnimationType::PLAYER2_RUN] = AnimationClip(6, runFrame, LoopMode::LOOP);
+  animationClips[AnimationType::PLAYER2_TAKING_PUNCH] = AnimationClip(6, runFrame, LoopMode::ONCE);
 
-  // Pre-load common textures
-  getTexture("resources/textures/player1/idle.png");
-  getTexture("resources/textures/player1/run.png");
-  getTexture("resources/textures/player1/taking-punch.png");
+  namespace Player1Textures = Assets::textures::player1;
+
+  buildPlayerStateMachine(player1StateMachine, AnimationType::PLAYER1_IDLE, AnimationType::PLAYER1_RUN,
+                          AnimationType::PLAYER1_TAKING_PUNCH, Player1Textures::idle, Player1Textures::run,
+                          Player1Textures::taking_punch);
+  buildPlayerStateMachine(player2StateMachine, AnimationType::PLAYER2_IDLE, AnimationType::PLAYER2_RUN,
+                          AnimationType::PLAYER2_TAKING_PUNCH, Player1Textures::idle, Player1Textures::run,
+                          Player1Textures::taking_punch);
 
   initialized = true;
+
+  // Pre-load common textures, the residency cache keeps them after the handles are dropped.
+  // Decoding starts right away, uploads wait for attachRenderer()
+  getTexture(Player1Textures::idle);
+  getTexture(Player1Textures::run);
+  getTexture(Player1Textures::taking_punch);
+
   return true;
 }
 
+void ResourceManager::attachRenderer(SDL_Renderer *renderer) {
+  this->renderer = renderer;
+}
+
 void ResourceManager::cleanup() {
   if (!initialized) {
     return;
   }
 
-  textureCache.clear();
+  assetWatcher.stop();
+  changedPaths.clear();
+
+  // Joins the workers after they finish any in-flight decodes
+  decodePool.reset();
+  for (auto &decoded : decodedImages) {
+    SDL_DestroySurface(decoded.surface);
+  }
+  decodedImages.clear();
+  texturesRequested = texturesCompleted = 0;
+
+  residency.clear();
 
-  animations.clear();
+  player1StateMachine = AnimationStateMachine();
+  player2StateMachine = AnimationStateMachine();
+  animationClips.clear();
 
   fontManager.cleanup();
+  archive.close();
 
   renderer = nullptr;
   initialized = false;
 }
 
-shared_texture ResourceManager::getTexture(const std::string &path) {
-  if (!initialized || !renderer) {
-    return nullptr;
+TextureHandle ResourceManager::getTexture(AssetId id) {
+  if (!initialized) {
+    return TextureHandle();
+  }
+
+  if (auto resident = residency.acquire(id)) {
+    return TextureHandle(resident);
+  }
+
+  auto resource = std::make_shared<TextureResource>();
+  resource->id = id;
+  resource->path = std::string(id.getPath());
+  residency.insert(resource);
+
+  requestDecode(resource);
+
+  return TextureHandle(resource);
+}
+
+void ResourceManager::requestDecode(const std::shared_ptr<TextureResource> &resource, bool reload) {
+  // A new batch starts when nothing else is in flight
+  if (!isLoading()) {
+    loadStats = TextureLoadStats{};
+    loadStats.startCounter = SDL_GetPerformanceCounter();
   }
+  texturesRequested++;
+
+  std::weak_ptr<TextureResource> weakResource = resource;
+  std::string path = resource->path;
 
-  auto it = textureCache.find(path);
-  if (it != textureCache.end()) {
-    if (auto shared = it->second.lock()) {
-      return shared;
+  decodePool->enqueue([this, weakResource, path, reload]() {
+    PROFILE_ZONE("Texture decode");
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    DecodedImage decoded{weakResource, path, nullptr};
+    decoded.reload = reload;
+
+    AssetView cookedBlob;
+    if (reload) {
+      // The archive still holds the old data, read the edited file itself
+      decoded.surface = IMG_Load(path.c_str());
+    } else if (useCookedAssets && archive.find(cookedPathFor(path), cookedBlob)) {
+      decoded.surface = decodeCooked(cookedBlob, decoded);
     } else {
-      textureCache.erase(it);
+      decoded.surface = IMG_Load_IO(archive.openIO(path), true);
+    }
+
+    if (!decoded.surface) {
+      std::cerr << "Error decoding " << path << ": " << SDL_GetError() << '\n';
     }
+
+    decoded.decodeMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+    std::lock_guard<std::mutex> lock(decodedMutex);
+    decodedImages.push_back(std::move(decoded));
+  });
+}
+
+std::string ResourceManager::cookedPathFor(const std::string &path) {
+  size_t extension = path.find_last_of('.');
+  return path.substr(0, extension) + CookedTextureFormat::EXTENSION;
+}
+
+SDL_Surface *ResourceManager::decodeCooked(const AssetView &blob, DecodedImage &decoded) const {
+  using namespace CookedTextureFormat;
+
+  CookedTextureHeader header;
+  if (blob.size < sizeof(header)) {
+    return nullptr;
   }
+  std::memcpy(&header, blob.data, sizeof(header));
 
-  auto texture = loadTexture(path);
-  if (texture) {
-    textureCache[path] = texture;
+  size_t framesSize = sizeof(CookedFrame) * header.frameCount;
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+      blob.size < sizeof(header) + framesSize + header.compressedSize) {
+    SDL_SetError("Invalid cooked texture");
+    return nullptr;
+  }
+
+  decoded.cooked = true;
+  decoded.hitbox = SDL_FRect{header.hitboxX, header.hitboxY, header.hitboxW, header.hitboxH};
+  decoded.frameBounds.resize(header.frameCount);
+  std::memcpy(decoded.frameBounds.data(), blob.data + sizeof(header), framesSize);
+
+  SDL_Surface *surface = SDL_CreateSurface(static_cast<int>(header.width), static_cast<int>(header.height),
+                                           static_cast<SDL_PixelFormat>(header.pixelFormat));
+  if (!surface) {
+    return nullptr;
   }
 
-  return texture;
+  // Rows were packed without padding, 32-bit surfaces have the same pitch
+  const int rawSize = static_cast<int>(header.width * header.height * 4);
+  const char *compressed = reinterpret_cast<const char *>(blob.data + sizeof(header) + framesSize);
+  if (surface->pitch != static_cast<int>(header.width * 4) ||
+      LZ4_decompress_safe(compressed, static_cast<char *>(surface->pixels), static_cast<int>(header.compressedSize), rawSize) != rawSize) {
+    SDL_DestroySurface(surface);
+    SDL_SetError("Corrupt cooked texture data");
+    return nullptr;
+  }
+
+  return surface;
+}
+
+void ResourceManager::queueChangedTextures() {
+  std::vector<std::string> paths;
+  {
+    std::lock_guard<std::mutex> lock(changedMutex);
+    paths.swap(changedPaths);
+  }
+
+  for (const auto &path : paths) {
+    // Only textures still resident are worth reloading
+    if (auto resource = residency.find(AssetId(path))) {
+      std::cout << "Reloading " << path << '\n';
+      requestDecode(resource, true);
+    }
+  }
 }
 
-shared_texture ResourceManager::loadTexture(const std::string &filePath) {
-  SDL_Texture *tex = IMG_LoadTexture(renderer, filePath.c_str());
+void ResourceManager::processUploads(double budgetMs) {
+  if (!renderer)
+    return;
+
+  const Uint64 start = SDL_GetPerformanceCounter();
+  const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+  if (hotReload) {
+    queueChangedTextures();
+  }
+
+  while (true) {
+    DecodedImage decoded;
+    {
+      std::lock_guard<std::mutex> lock(decodedMutex);
+      if (decodedImages.empty())
+        break;
+
+      decoded = std::move(decodedImages.front());
+      decodedImages.pop_front();
+    }
+
+    const Uint64 uploadStart = SDL_GetPerformanceCounter();
+
+    // Every handle may have been dropped while the image was decoding
+    if (auto resource = decoded.resource.lock()) {
+      PROFILE_ZONE("Texture upload");
+      uploadTexture(*resource, decoded);
+    }
+    SDL_DestroySurface(decoded.surface);
+    texturesCompleted++;
+
+    loadStats.decodeMs += decoded.decodeMs;
+    loadStats.uploadMs += (SDL_GetPerformanceCounter() - uploadStart) / frequency * 1000.0;
+    loadStats.textureCount++;
+    if (decoded.cooked)
+      loadStats.cookedCount++;
+
+    if (!isLoading()) {
+      loadStats.wallMs = (SDL_GetPerformanceCounter() - loadStats.startCounter) / frequency * 1000.0;
+      std::cout << std::format("Loaded {} textures ({} cooked) in {:.2f} ms, decode {:.2f} ms, upload {:.2f} ms",
+                               loadStats.textureCount, loadStats.cookedCount, loadStats.wallMs,
+                               loadStats.decodeMs, loadStats.uploadMs)
+                << '\n';
+    }
+
+    double elapsedMs = (SDL_GetPerformanceCounter() - start) / frequency * 1000.0;
+    if (elapsedMs >= budgetMs)
+      break;
+  }
+
+  residency.enforceBudget();
+}
+
+void ResourceManager::uploadTexture(TextureResource &resource, const DecodedImage &decoded) {
+  SDL_Surface *surface = decoded.surface;
+  SDL_Texture *tex = nullptr;
+
+  if (surface && decoded.cooked) {
+    // Already in the final format, a static texture and one update without any conversion
+    tex = SDL_CreateTexture(renderer, surface->format, SDL_TEXTUREACCESS_STATIC, surface->w, surface->h);
+    if (tex && !SDL_UpdateTexture(tex, nullptr, surface->pixels, surface->pitch)) {
+      SDL_DestroyTexture(tex);
+      tex = nullptr;
+    }
+  } else if (surface) {
+    tex = SDL_CreateTextureFromSurface(renderer, surface);
+  }
+
+  if (!tex && decoded.reload) {
+    // A half-written or broken file keeps the previous texture on screen
+    std::cerr << "Error reloading texture: " << resource.path << " - " << SDL_GetError() << '\n';
+    return;
+  }
+
   if (!tex) {
+    resource.state = TextureLoadState::FAILED;
     SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error",
-                             std::format("Error loading texture: {} - {}", filePath, SDL_GetError()).c_str(), nullptr);
-    return nullptr;
+                             std::format("Error loading texture: {} - {}", resource.path, SDL_GetError()).c_str(), nullptr);
+    return;
   }
 
   SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_NEAREST);
+  SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+
+  // Runs between frames, every handle sees the new texture from the next render on
+  resource.texture = shared_texture(tex, SDLDeleter{});
+  SDL_GetTextureSize(tex, &resource.width, &resource.height);
+  resource.bytes = static_cast<size_t>(resource.width * resource.height) * SDL_BYTESPERPIXEL(tex->format);
+  resource.frameBounds = decoded.frameBounds;
+  resource.hitbox = decoded.hitbox;
+  resource.hasHitbox = decoded.cooked && decoded.hitbox.w > 0;
+  resource.state = TextureLoadState::READY;
+}
 
-  return std::shared_ptr<SDL_Texture>(tex, SDLDeleter{});
+float ResourceManager::getLoadProgress() const {
+  if (texturesRequested == 0)
+    return 1.0f;
+  return static_cast<float>(texturesCompleted) / texturesRequested;
 }
 
-const Animation &ResourceManager::getAnimation(AnimationType type) const {
-  auto it = animations.find(type);
-  if (it != animations.end()) {
+const AnimationClip &ResourceManager::getAnimationClip(AnimationType type) const {
+  auto it = animationClips.find(type);
+  if (it != animationClips.end()) {
     return it->second;
   }
 
-  static Animation defaultAnim(1, 1.0f);
-  return defaultAnim;
+  static const AnimationClip defaultClip(1, 1.0f, LoopMode::LOOP);
+  return defaultClip;
 }
 
-std::vector<Animation> ResourceManager::getPlayerAnimations(bool isPrimaryPlayer) const {
-  std::vector<Animation> playerAnims;
-  playerAnims.reserve(3);
+const AnimationStateMachine &ResourceManager::getPlayerStateMachine(bool isPrimaryPlayer) const {
+  return isPrimaryPlayer ? player1StateMachine : player2StateMachine;
+}
 
-  if (isPrimaryPlayer) {
-    playerAnims.push_back(getAnimation(AnimationType::PLAYER1_IDLE));
-    playerAnims.push_back(getAnimation(AnimationType::PLAYER1_RUN));
-    playerAnims.push_back(getAnimation(AnimationType::PLAYER1_TAKING_PUNCH));
-  } else {
-    playerAnims.push_back(getAnimation(AnimationType::PLAYER2_IDLE));
-    playerAnims.push_back(getAnimation(AnimationType::PLAYER2_RUN));
-    playerAnims.push_back(getAnimation(AnimationType::PLAYER2_TAKING_PUNCH));
-  }
+void ResourceManager::buildPlayerStateMachine(AnimationStateMachine &machine, AnimationType idle, AnimationType run,
+                                              AnimationType takingPunch, AssetId idleTexture, AssetId runTexture,
+                                              AssetId takingPunchTexture) {
+  using Condition = AnimationCondition;
+
+  auto idleState = machine.addState("Idle", &getAnimationClip(idle), idleTexture);
+  auto runState = machine.addState("Run", &getAnimationClip(run), runTexture);
+  auto takingPunchState = machine.addState("Taking punch", &getAnimationClip(takingPunch), takingPunchTexture);
+
+  machine.addTransitionFromAny(takingPunchState, conditionMask(Condition::HIT));
+
+  machine.addTransition(idleState, runState, conditionMask(Condition::MOVING));
+
+  machine.addTransition(runState, idleState, conditionMask(Condition::STOPPED), conditionMask(Condition::MOVING));
+
+  machine.addTransition(takingPunchState, runState, conditionMask(Condition::MOVING));
+  machine.addTransition(takingPunchState, idleState, conditionMask(Condition::CLIP_DONE));
 
-  return playerAnims;
+  machine.compile();
 }
@@ -0,0 +1,66 @@
+#include "managers/TextureResidency.h"
+
+TextureResidency::TextureResidency(size_t budgetBytes) : budgetBytes(budgetBytes) {
+}
+
+std::shared_ptr<TextureResource> TextureResidency::acquire(AssetId id) {
+  Entry *entry = entries.find(id);
+
+  // A failed load is retried, the caller's insert replaces the entry
+  if (!entry || entry->resource->state == TextureLoadState::FAILED) {
+    misses++;
+    return nullptr;
+  }
+
+  hits++;
+  lruOrder.splice(lruOrder.begin(), lruOrder, entry->lruPosition);
+  return entry->resource;
+}
+
+void TextureResidency::insert(const std::shared_ptr<TextureResource> &resource) {
+  if (Entry *entry = entries.find(resource->id)) {
+    entry->resource = resource;
+    lruOrder.splice(lruOrder.begin(), lruOrder, entry->lruPosition);
+    return;
+  }
+
+  lruOrder.push_front(resource->id);
+  entries.insert(resource->id, Entry{resource, lruOrder.begin()});
+}
+
+std::shared_ptr<TextureResource> TextureResidency::find(AssetId id) const {
+  const Entry *entry = entries.find(id);
+  return entry ? entry->resource : nullptr;
+}
+
+void TextureResidency::enforceBudget() {
+  // Sizes change when uploads finish or textures are reloaded, so recount every time
+  residentBytes = 0;
+  entries.forEach([this](const Entry &entry) { residentBytes += entry.resource->bytes; });
+
+  for (auto it = lruOrder.end(); it != lruOrder.begin() && residentBytes > budgetBytes;) {
+    --it;
+    const Entry *entry = entries.find(*it);
+
+    // Held by a handle, or still loading and about to be used
+    if (entry->resource.use_count() > 1 || entry->resource->state == TextureLoadState::PENDING)
+      continue;
+
+    residentBytes -= entry->resource->bytes;
+    entries.erase(*it);
+    it = lruOrder.erase(it);
+    evictions++;
+  }
+}
+
+void TextureResidency::clear() {
+  entries.clear();
+  lruOrder.clear();
+  residentBytes = 0;
+  hits = misses = evictions = 0;
+}
+
+float TextureResidency::getHitRate() const {
+  size_t lookups = hits + misses;
+  return lookups > 0 ? static_cast<float>(hits) / lookups : 0.0f;
+}
@@ -0,0 +1,102 @@
+#include "managers/TraceWriter.h"
+
+#include <format>
+#include <iostream>
+
+TraceWriter::~TraceWriter() {
+  close();
+}
+
+bool TraceWriter::open(const std::string &path) {
+  if (isOpen())
+    return false;
+
+  file.open(path, std::ios::trunc);
+  if (!file) {
+    std::cerr << "Failed to open trace file: " << path << '\n';
+    return false;
+  }
+
+  // Timestamps are relative to the moment tracing started
+  originCounter = SDL_GetPerformanceCounter();
+  firstEvent = true;
+  stopping = false;
+
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  writerThread = std::thread([this]() { writerLoop(); });
+  return true;
+}
+
+void TraceWriter::close() {
+  if (!isOpen())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    stopping = true;
+  }
+  pendingCondition.notify_one();
+  writerThread.join();
+
+  file << "\n]}\n";
+  file.close();
+}
+
+void TraceWriter::submit(const std::vector<Profiler::Sample> &samples) {
+  {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingSamples.insert(pendingSamples.end(), samples.begin(), samples.end());
+  }
+  pendingCondition.notify_one();
+}
+
+void TraceWriter::writerLoop() {
+  std::vector<Profiler::Sample> batch;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(pendingMutex);
+      pendingCondition.wait(lock, [this]() { return stopping || !pendingSamples.empty(); });
+
+      if (pendingSamples.empty() && stopping)
+        return;
+
+      batch.swap(pendingSamples);
+    }
+
+    writeEvents(batch);
+    batch.clear();
+  }
+}
+
+void TraceWriter::writeEvents(const std::vector<Profiler::Sample> &samples) {
+  const double counterToUs = 1000000.0 / SDL_GetPerformanceFrequency();
+
+  std::string json;
+  for (const Profiler::Sample &sample : samples) {
+    // Game registers the main thread first, the other indices are pool workers
+    if (sample.threadIndex >= namedThreads.size())
+      namedThreads.resize(sample.threadIndex + 1, false);
+    if (!namedThreads[sample.threadIndex]) {
+      namedThreads[sample.threadIndex] = true;
+      json += std::format("{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+                          firstEvent ? "" : ",\n", sample.threadIndex,
+                          sample.threadIndex == 0 ? std::string("Main") : std::format("Worker {}", sample.threadIndex));
+      firstEvent = false;
+    }
+
+    // Samples recorded just before tracing started are clamped to its start
+    double startUs = sample.startCounter > originCounter ? (sample.startCounter - originCounter) * counterToUs : 0.0;
+    double endUs = sample.endCounter > originCounter ? (sample.endCounter - originCounter) * counterToUs : 0.0;
+
+    json += std::format("{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}",
+                        firstEvent ? "" : ",\n", sample.zone, sample.threadIndex, startUs, endUs - startUs);
+    if (sample.allocations > 0) {
+      json += std::format(",\"args\":{{\"allocations\":{},\"bytes\":{}}}", sample.allocations, sample.allocatedBytes);
+    }
+    json += "}";
+    firstEvent = false;
+  }
+
+  file << json;
+}
@@ -1,20 +1,26 @@
 #include "views/GameLoop.h"
 
+#include "AllocationTracker.h"
 #include "GameConfig.h"
 #include "managers/CollisionManager.h"
 #include "managers/InputManager.h"
+#include "managers/RenderManager.h"
+#include "utils/Profiler.h"
+
+GameLoop::GameLoop(SDL_Renderer *renderer)
+    : camera(SDL_FRect{0, 0, GameConfig::STAGE_WIDTH, GameConfig::STAGE_HEIGHT},
+             GameConfig::LOGICAL_WIDTH, GameConfig::LOGICAL_HEIGHT) {
+  background = ParallaxBackground::createStage(renderer);
 
-GameLoop::GameLoop() {
   player1 = std::make_unique<Player>(true);
   player2 = std::make_unique<Player>(false);
 
-  player1->playIdleAnimation();
-  player2->playIdleAnimation();
-
   CollisionManager &collisionManager = CollisionManager::getInstance();
-  SDL_FRect worldBounds = {0, 0, GameConfig::LOGICAL_WIDTH, GameConfig::LOGICAL_HEIGHT};
+  SDL_FRect worldBounds = {0, 0, GameConfig::STAGE_WIDTH, GameConfig::STAGE_HEIGHT};
   collisionManager.setWorldBounds(worldBounds);
 
+  camera.follow(player1->getPosition(), player2->getPosition(), 0.0f, true);
+
   collisionManager.setOnPlayerHitCallback([this](Player *attacker, Player *defender) {
     // sound effects, particles
   });
@@ -25,25 +31,40 @@ GameLoop::GameLoop() {
 }
 
 GameLoop::~GameLoop() {
+  RenderManager::getInstance().resetCamera();
+
   player1.reset();
   player2.reset();
 }
 
-bool GameLoop::update(InputManager inputManager, float deltaTime) {
+bool GameLoop::update(const InputManager &inputManager, float deltaTime) {
+  PROFILE_ZONE("GameLoop::update");
+  NO_ALLOC_SCOPE("Simulation tick");
+
   handleInput(inputManager);
 
   player1->update(deltaTime);
   player2->update(deltaTime);
 
-  CollisionManager &collisionManager = CollisionManager::getInstance();
+  {
+    PROFILE_ZONE("Collisions");
+    CollisionManager &collisionManager = CollisionManager::getInstance();
+    collisionManager.beginFrame();
+
+    collisionManager.checkPlayerCollisions(player1.get(), player2.get());
 
-  collisionManager.checkPlayerCollisions(player1.get(), player2.get());
+    collisionManager.checkPlayerBoundaryCollisions(player1.get());
+    collisionManager.checkPlayerBoundaryCollisions(player2.get());
+
+    collisionManager.checkPlayerAttackCollisions(player1.get(), player2.get());
+    collisionManager.checkPlayerAttackCollisions(player2.get(), player1.get());
+  }
 
-  collisionManager.checkPlayerBoundaryCollisions(player1.get());
-  collisionManager.checkPlayerBoundaryCollisions(player2.get());
+  camera.follow(player1->getPosition(), player2->getPosition(), deltaTime);
 
-  collisionManager.checkPlayerAttackCollisions(player1.get(), player2.get());
-  collisionManager.checkPlayerAttackCollisions(player2.get(), player1.get());
+  // Background layers scroll in screen pixels, they are not zoomed with the world
+  background->setScroll(camera.getViewRect().x * camera.getZoom());
+  background->update(deltaTime);
 
   return true;
 }
@@ -92,9 +113,33 @@ void GameLoop::handleInput(const InputManager &inputManager) {
   if (!player2Moving) {
     player2->stopMoving();
   }
+
+  handleMotions(inputManager);
 }
 
-void GameLoop::render(SDL_Renderer *renderer) {
-  player1->render(renderer);
-  player2->render(renderer);
+void GameLoop::handleMotions(const InputManager &inputManager) {
+  Player *players[] = {player1.get(), player2.get()};
+
+  for (size_t index = 0; index < inputHistories.size(); ++index) {
+    inputHistories[index].push(inputManager.getActionBits(static_cast<PlayerId>(index)));
+
+    // Motions are relative to the opponent, the direction of the player only follows the held direction
+    Player *player = players[index];
+    Player *opponent = players[1 - index];
+    float facing = opponent->getPosition().x >= player->getPosition().x ? 1.0f : -1.0f;
+
+    SpecialMove move = motionRecognizer.step(motionTrackers[index], inputHistories[index], facing);
+    if (move != SpecialMove::NONE) {
+      player->performSpecial(move, facing);
+    }
+  }
+}
+
+void GameLoop::render() {
+  RenderManager::getInstance().setCamera(camera);
+
+  background->render();
+
+  player1->render();
+  player2->render();
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "views/LoadingScreen.h"
+
+#include <algorithm>
+
+#include "GameConfig.h"
+#include "managers/RenderManager.h"
+#include "managers/ResourceManager.h"
+
+LoadingScreen::LoadingScreen() {
+}
+
+LoadingScreen::~LoadingScreen() {
+}
+
+void LoadingScreen::update(float deltaTime) {
+  float progress = ResourceManager::getInstance().getLoadProgress();
+
+  // Ease towards the real value so a burst of uploads doesn't make the bar jump
+  displayedProgress = std::min(progress, displayedProgress + deltaTime * 4.0f);
+}
+
+void LoadingScreen::render() {
+  RenderManager &renderManager = RenderManager::getInstance();
+
+  const float barWidth = 200.0f;
+  const float barHeight = 8.0f;
+  const float barX = (GameConfig::LOGICAL_WIDTH - barWidth) / 2.0f;
+  const float barY = (GameConfig::LOGICAL_HEIGHT - barHeight) / 2.0f;
+
+  SDL_FRect frame = {barX - 2, barY - 2, barWidth + 4, barHeight + 4};
+  SDL_FRect fill = {barX, barY, barWidth * displayedProgress, barHeight};
+
+  renderManager.drawRect(RenderLayer::UI, frame, {200, 200, 200, 255});
+  renderManager.fillRect(RenderLayer::UI, fill, {150, 30, 30, 255});
+  renderManager.drawDebugText(RenderLayer::UI, barX, barY - 16, "Loading...", {255, 255, 255, 255});
+}
+
+bool LoadingScreen::isFinished() const {
+  return !ResourceManager::getInstance().isLoading() && displayedProgress >= 1.0f;
+}
@@ -1,12 +1,13 @@
 #include "views/MainMenu.h"
 
-#include <SDL3_ttf/SDL_ttf.h>
-
 #include <glm/glm.hpp>
 
 #include "GameConfig.h"
+#include "managers/RenderManager.h"
+
+MainMenu::MainMenu(SDL_Renderer *renderer) {
+  background = ParallaxBackground::createMainMenu(renderer);
 
-MainMenu::MainMenu() {
   float buttonWidth = 150.0f;
   float buttonHeight = 45.0f;
   float buttonX = (GameConfig::LOGICAL_WIDTH - buttonWidth) / 2.0f;
@@ -25,7 +26,9 @@ bool pointInRect(const SDL_FRect &rect, const glm::vec2 point) {
   return xOverlap && yOverlap;
 }
 
-void MainMenu::update(const InputManager &inputManager, SDL_Renderer *renderer) {
+void MainMenu::update(const InputManager &inputManager, SDL_Renderer *renderer, float deltaTime) {
+  background->update(deltaTime);
+
   for (auto &[id, button] : buttons) {
     glm::vec2 cursorPosition = inputManager.getCursorPosition(renderer);
 
@@ -41,36 +44,25 @@ void MainMenu::update(const InputManager &inputManager, SDL_Renderer *renderer)
 }
 
 void MainMenu::render(SDL_Renderer *renderer) {
-  // TODO: render background texture
+  background->render();
 
-  for (auto &[id, button] : buttons) {
-    if (button.currentState == ButtonState::HOVERED) {
-      SDL_SetRenderDrawColor(renderer, 100, 100, 150, 255);
-    } else {
-      SDL_SetRenderDrawColor(renderer, 60, 60, 100, 255);
-    }
-
-    SDL_RenderFillRect(renderer, &button.dimensions);
+  RenderManager &renderManager = RenderManager::getInstance();
 
-    SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-    SDL_RenderRect(renderer, &button.dimensions);
+  for (auto &[id, button] : buttons) {
+    SDL_Color fillColor = button.currentState == ButtonState::HOVERED ? SDL_Color{100, 100, 150, 255}
+                                                                      : SDL_Color{60, 60, 100, 255};
+    renderManager.fillRect(RenderLayer::UI, button.dimensions, fillColor);
+    renderManager.drawRect(RenderLayer::UI, button.dimensions, {200, 200, 200, 255}, SDL_BLENDMODE_NONE, 1.0f);
 
     // Render button text
-    SDL_Color textColor = {255, 255, 255, 255};  // White text
-    unique_texture textTexture(renderText(renderer, button.text, textColor, 24));
-
-    if (textTexture != nullptr) {
-      float textWidth, textHeight;
-      SDL_GetTextureSize(textTexture.get(), &textWidth, &textHeight);
+    if (const SDFFontAtlas *font = ResourceManager::getInstance().getFontAtlas()) {
+      const float fontSize = 24.0f;
+      SDL_FPoint textSize = font->measureText(button.text, fontSize);
 
       // Center the text on the button
-      SDL_FRect textRect = {
-          button.dimensions.x + (button.dimensions.w - textWidth) / 2.0f,
-          button.dimensions.y + (button.dimensions.h - textHeight) / 2.0f,
-          textWidth,
-          textHeight};
-
-      SDL_RenderTexture(renderer, textTexture.get(), nullptr, &textRect);
+      font->drawText(RenderLayer::UI, button.dimensions.x + (button.dimensions.w - textSize.x) / 2.0f,
+                     button.dimensions.y + (button.dimensions.h - textSize.y) / 2.0f, button.text, fontSize,
+                     {255, 255, 255, 255}, 2.0f);
     }
   }
 }
@@ -85,23 +77,4 @@ void MainMenu::startGame() {
 
 void MainMenu::quitGame() {
   actionToken = MainMenuAction::QUIT;
-}
-
-SDL_Texture *MainMenu::renderText(SDL_Renderer *renderer, const std::string &text, SDL_Color color, int fontSize) {
-  ResourceManager &resources = ResourceManager::getInstance();
-  TTF_Font *font = resources.getFontManager().getFont(fontSize);
-  if (font == nullptr) {
-    std::cerr << "No font available for size " << fontSize << '\n';
-    return nullptr;
-  }
-
-  unique_surface textSurface(TTF_RenderText_Solid(font, text.c_str(), text.length(), color));
-  if (textSurface == nullptr) {
-    std::cerr << "TTF_RenderText_Solid Error: " << SDL_GetError() << '\n';
-    return nullptr;
-  }
-
-  SDL_Texture *textTexture = SDL_CreateTextureFromSurface(renderer, textSurface.get());
-
-  return textTexture;
 }
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "views/StressTest.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+#include "GameConfig.h"
+#include "managers/RenderManager.h"
+#include "utils/Profiler.h"
+
+StressTest::StressTest(SDL_Renderer *renderer, size_t targetFighterCount)
+    : targetFighterCount(std::max<size_t>(targetFighterCount, 1)),
+      camera(SDL_FRect{0, 0, GameConfig::STAGE_WIDTH, GameConfig::STAGE_HEIGHT},
+             GameConfig::LOGICAL_WIDTH, GameConfig::LOGICAL_HEIGHT) {
+  background = ParallaxBackground::createStage(renderer);
+
+  CollisionManager &collisionManager = CollisionManager::getInstance();
+  collisionManager.clearAll();
+  collisionManager.setWorldBounds(SDL_FRect{0, 0, GameConfig::STAGE_WIDTH, GameConfig::STAGE_HEIGHT});
+
+  // The whole stage stays in view
+  float stageZoom = static_cast<float>(GameConfig::LOGICAL_WIDTH) / GameConfig::STAGE_WIDTH;
+  camera.setZoomLimits(stageZoom, stageZoom);
+  camera.follow(glm::vec2(0.0f), glm::vec2(GameConfig::STAGE_WIDTH, 0.0f), 0.0f, true);
+
+  stages.push_back(StageTimings{});
+  stages.back().fighterCount = std::min(FIRST_STAGE_COUNT, this->targetFighterCount);
+  spawnFighters(stages.back().fighterCount);
+
+  std::cout << "Stress test up to " << this->targetFighterCount << " fighters" << '\n';
+  std::cout << std::format("{:>8} {:>22} {:>22} {:>22}", "fighters", "update p50/p99 ms", "collision p50/p99 ms",
+                           "render p50/p99 ms")
+            << '\n';
+}
+
+StressTest::~StressTest() {
+  RenderManager::getInstance().resetCamera();
+  CollisionManager::getInstance().clearAll();
+}
+
+void StressTest::spawnFighters(size_t count) {
+  std::uniform_real_distribution<float> spawnX(40.0f, GameConfig::STAGE_WIDTH - 40.0f);
+  float groundY = GameConfig::LOGICAL_HEIGHT * GameConfig::PLAYER_Y_RATIO;
+
+  CollisionManager &collisionManager = CollisionManager::getInstance();
+
+  while (fighters.size() < count) {
+    auto fighter = std::make_unique<Player>(fighters.size() % 2 == 0);
+    fighter->setPosition(glm::vec2(spawnX(random), groundY));
+
+    colliders.push_back(std::make_shared<FighterCollider>(fighter.get()));
+    collisionManager.registerCollidable(colliders.back());
+
+    fighters.push_back(std::move(fighter));
+    brains.push_back(Brain{});
+  }
+}
+
+void StressTest::think(Player &player, Brain &brain, float deltaTime) {
+  brain.timeLeft -= deltaTime;
+  if (brain.timeLeft <= 0.0f) {
+    std::uniform_int_distribution<int> intent(0, static_cast<int>(Intent::JUMP));
+    std::uniform_real_distribution<float> duration(0.3f, 1.5f);
+
+    brain.intent = static_cast<Intent>(intent(random));
+    brain.timeLeft = duration(random);
+  }
+
+  switch (brain.intent) {
+    case Intent::WALK_LEFT:
+      player.move(-1.0f);
+      break;
+    case Intent::WALK_RIGHT:
+      player.move(1.0f);
+      break;
+    case Intent::PUNCH:
+      player.stopMoving();
+      player.punch();
+      break;
+    case Intent::JUMP:
+      player.stopMoving();
+      player.jump();
+      break;
+    default:
+      player.stopMoving();
+      break;
+  }
+}
+
+void StressTest::update(float deltaTime) {
+  const double counterToMs = 1000.0 / SDL_GetPerformanceFrequency();
+
+  // Checked here rather than after the last measured update, so its render time is recorded first
+  if (!finished && stageFrame >= WARMUP_FRAMES + MEASURED_FRAMES) {
+    finishStage();
+  }
+
+  StageTimings &stage = stages.back();
+  measuredFrame = !finished && stageFrame >= WARMUP_FRAMES;
+
+  Uint64 updateStart = SDL_GetPerformanceCounter();
+  {
+    PROFILE_ZONE("StressTest::update");
+    for (size_t i = 0; i < fighters.size(); ++i) {
+      think(*fighters[i], brains[i], deltaTime);
+      fighters[i]->update(deltaTime);
+    }
+  }
+
+  Uint64 collisionStart = SDL_GetPerformanceCounter();
+  {
+    PROFILE_ZONE("Collisions");
+    CollisionManager &collisionManager = CollisionManager::getInstance();
+
+    // All pairs through the registered colliders, then the stage edges per fighter
+    collisionManager.update(deltaTime);
+    for (auto &fighter : fighters) {
+      collisionManager.checkPlayerBoundaryCollisions(fighter.get());
+    }
+  }
+  Uint64 collisionEnd = SDL_GetPerformanceCounter();
+
+  background->update(deltaTime);
+
+  if (measuredFrame) {
+    stage.updateTimes.record(static_cast<uint64_t>((collisionStart - updateStart) * counterToMs * 1000.0));
+    stage.collisionTimes.record(static_cast<uint64_t>((collisionEnd - collisionStart) * counterToMs * 1000.0));
+  }
+
+  if (!finished) {
+    stageFrame++;
+  }
+}
+
+void StressTest::recordRenderTime(double renderMs) {
+  if (measuredFrame) {
+    stages.back().renderTimes.record(static_cast<uint64_t>(renderMs * 1000.0));
+  }
+}
+
+void StressTest::finishStage() {
+  const StageTimings &stage = stages.back();
+
+  auto column = [](const HdrHistogram &histogram) {
+    return std::format("{:.2f}/{:.2f}", histogram.getValueAtPercentile(50.0) / 1000.0,
+                       histogram.getValueAtPercentile(99.0) / 1000.0);
+  };
+  std::cout << std::format("{:>8} {:>22} {:>22} {:>22}", stage.fighterCount, column(stage.updateTimes),
+                           column(stage.collisionTimes), column(stage.renderTimes))
+            << '\n';
+
+  // push_back may reallocate and invalidate stage
+  size_t fighterCount = stage.fighterCount;
+  if (fighterCount >= targetFighterCount) {
+    finished = true;
+    writeReport();
+    return;
+  }
+
+  stages.push_back(StageTimings{});
+  stages.back().fighterCount = std::min(fighterCount * 2, targetFighterCount);
+  stageFrame = 0;
+
+  spawnFighters(stages.back().fighterCount);
+}
+
+void StressTest::writeReport() const {
+  std::ofstream file(REPORT_FILE, std::ios::trunc);
+  if (!file) {
+    std::cerr << "Failed to write stress report: " << REPORT_FILE << '\n';
+    return;
+  }
+
+  file << "fighters,update_p50_ms,update_p99_ms,collision_p50_ms,collision_p99_ms,render_p50_ms,render_p99_ms\n";
+  for (const StageTimings &stage : stages) {
+    file << std::format("{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f}\n", stage.fighterCount,
+                        stage.updateTimes.getValueAtPercentile(50.0) / 1000.0,
+                        stage.updateTimes.getValueAtPercentile(99.0) / 1000.0,
+                        stage.collisionTimes.getValueAtPercentile(50.0) / 1000.0,
+                        stage.collisionTimes.getValueAtPercentile(99.0) / 1000.0,
+                        stage.renderTimes.getValueAtPercentile(50.0) / 1000.0,
+                        stage.renderTimes.getValueAtPercentile(99.0) / 1000.0);
+  }
+
+  std::cout << "Stress test complete, report written to " << REPORT_FILE << '\n';
+}
+
+void StressTest::render() {
+  RenderManager::getInstance().setCamera(camera);
+
+  background->render();
+
+  for (auto &fighter : fighters) {
+    fighter->render();
+  }
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+
+#include "InputHistory.h"
+#include "MotionRecognizer.h"
+
+namespace {
+
+constexpr uint8_t bit(PlayerAction action) {
+  return static_cast<uint8_t>(1u << static_cast<uint8_t>(action));
+}
+
+constexpr uint8_t LEFT = bit(PlayerAction::MoveLeft);
+constexpr uint8_t RIGHT = bit(PlayerAction::MoveRight);
+constexpr uint8_t DOWN = bit(PlayerAction::Crouch);
+constexpr uint8_t PUNCH = bit(PlayerAction::Punch);
+
+// Feeds one tick per entry and returns the last move that completed
+SpecialMove feedTicks(const MotionRecognizer &recognizer, float facing, std::initializer_list<uint8_t> ticks) {
+  InputHistory history;
+  MotionRecognizer::Tracker tracker;
+  SpecialMove last = SpecialMove::NONE;
+
+  for (uint8_t actionBits : ticks) {
+    history.push(actionBits);
+    SpecialMove move = recognizer.step(tracker, history, facing);
+    if (move != SpecialMove::NONE)
+      last = move;
+  }
+  return last;
+}
+
+class MotionRecognizerTest : public ::testing::Test {
+ protected:
+  MotionRecognizer recognizer = MotionRecognizer::createMoveList();
+};
+
+}  // namespace
+
+TEST_F(MotionRecognizerTest, QuarterCircleTowardsTheRightIsForwardWhenFacingRight) {
+  EXPECT_EQ(feedTicks(recognizer, 1.0f, {DOWN, DOWN | RIGHT, RIGHT, RIGHT | PUNCH}), SpecialMove::LUNGE_PUNCH);
+  EXPECT_EQ(feedTicks(recognizer, 1.0f, {DOWN, DOWN | LEFT, LEFT, LEFT | PUNCH}), SpecialMove::RETREAT_PUNCH);
+}
+
+TEST_F(MotionRecognizerTest, QuarterCircleTowardsTheLeftIsForwardWhenFacingLeft) {
+  EXPECT_EQ(feedTicks(recognizer, -1.0f, {DOWN, DOWN | LEFT, LEFT, LEFT | PUNCH}), SpecialMove::LUNGE_PUNCH);
+  EXPECT_EQ(feedTicks(recognizer, -1.0f, {DOWN, DOWN | RIGHT, RIGHT, RIGHT | PUNCH}), SpecialMove::RETREAT_PUNCH);
+}
+
+TEST_F(MotionRecognizerTest, DiagonalMayBeSkipped) {
+  EXPECT_EQ(feedTicks(recognizer, 1.0f, {DOWN, RIGHT, RIGHT | PUNCH}), SpecialMove::LUNGE_PUNCH);
+  EXPECT_EQ(feedTicks(recognizer, -1.0f, {DOWN, RIGHT, RIGHT | PUNCH}), SpecialMove::RETREAT_PUNCH);
+}
+
+TEST_F(MotionRecognizerTest, PunchWithoutMotionDoesNothing) {
+  EXPECT_EQ(feedTicks(recognizer, 1.0f, {RIGHT, RIGHT | PUNCH}), SpecialMove::NONE);
+}
+
+TEST_F(MotionRecognizerTest, MotionExpiresAfterTheWindow) {
+  InputHistory history;
+  MotionRecognizer::Tracker tracker;
+
+  // Down, then the diagonal held for longer than the window
+  history.push(DOWN);
+  recognizer.step(tracker, history, 1.0f);
+  for (int tick = 0; tick <= MotionRecognizer::MOTION_WINDOW_TICKS + 1; ++tick) {
+    history.push(DOWN | RIGHT);
+    recognizer.step(tracker, history, 1.0f);
+  }
+
+  history.push(RIGHT);
+  recognizer.step(tracker, history, 1.0f);
+  history.push(RIGHT | PUNCH);
+  EXPECT_EQ(recognizer.step(tracker, history, 1.0f), SpecialMove::NONE);
+}
@@ -0,0 +1,161 @@
+// Converts a texture strip into a cooked .tex blob: pixels in the renderer's format,
+// LZ4 compressed, with per-frame opaque bounds and a hitbox computed offline.
+//
+//   AssetCooker <input image> <output .tex> <frame count> [pixel format]
+//
+// The pixel format defaults to ARGB8888, the native texture format of most SDL renderers.
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <lz4hc.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/CookedTextureFormat.h"
+#include "utils/SDLDeleter.h"
+
+using namespace CookedTextureFormat;
+
+SDL_PixelFormat parsePixelFormat(std::string_view name) {
+  if (name == "ARGB8888")
+    return SDL_PIXELFORMAT_ARGB8888;
+  if (name == "ABGR8888")
+    return SDL_PIXELFORMAT_ABGR8888;
+  if (name == "RGBA8888")
+    return SDL_PIXELFORMAT_RGBA8888;
+  if (name == "BGRA8888")
+    return SDL_PIXELFORMAT_BGRA8888;
+  return SDL_PIXELFORMAT_UNKNOWN;
+}
+
+// Bounds of the pixels with non-zero alpha inside one frame, empty frames keep a zero rect
+CookedFrame opaqueBounds(const SDL_Surface *rgba, int frameX, int frameWidth) {
+  int minX = frameWidth, minY = rgba->h, maxX = -1, maxY = -1;
+
+  for (int y = 0; y < rgba->h; ++y) {
+    const uint8_t *row = static_cast<const uint8_t *>(rgba->pixels) + y * rgba->pitch;
+    for (int x = 0; x < frameWidth; ++x) {
+      // RGBA32 is byte ordered, alpha is always the fourth byte
+      if (row[(frameX + x) * 4 + 3] != 0) {
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+      }
+    }
+  }
+
+  if (maxX < 0)
+    return CookedFrame{0, 0, 0, 0};
+
+  return CookedFrame{static_cast<float>(minX), static_cast<float>(minY),
+                     static_cast<float>(maxX - minX + 1), static_cast<float>(maxY - minY + 1)};
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 4 || argc > 5) {
+    std::cerr << "Usage: " << argv[0] << " <input image> <output .tex> <frame count> [pixel format]" << '\n';
+    return 1;
+  }
+
+  const std::string inputPath = argv[1];
+  const std::string outputPath = argv[2];
+  const int frameCount = std::atoi(argv[3]);
+  const SDL_PixelFormat pixelFormat = argc == 5 ? parsePixelFormat(argv[4]) : SDL_PIXELFORMAT_ARGB8888;
+
+  if (frameCount <= 0) {
+    std::cerr << "Invalid frame count: " << argv[3] << '\n';
+    return 1;
+  }
+  if (pixelFormat == SDL_PIXELFORMAT_UNKNOWN) {
+    std::cerr << "Unsupported pixel format: " << argv[4] << '\n';
+    return 1;
+  }
+
+  unique_surface source(IMG_Load(inputPath.c_str()));
+  if (!source) {
+    std::cerr << "Failed to load " << inputPath << ": " << SDL_GetError() << '\n';
+    return 1;
+  }
+
+  unique_surface rgba(SDL_ConvertSurface(source.get(), SDL_PIXELFORMAT_RGBA32));
+  unique_surface cooked(SDL_ConvertSurface(source.get(), pixelFormat));
+  if (!rgba || !cooked) {
+    std::cerr << "Failed to convert " << inputPath << ": " << SDL_GetError() << '\n';
+    return 1;
+  }
+
+  const int width = cooked->w;
+  const int height = cooked->h;
+  const int frameWidth = width / frameCount;
+
+  // Opaque bounds of every frame, the game draws only these. Their union becomes the hitbox.
+  std::vector<CookedFrame> frames;
+  CookedFrame hitbox{0, 0, 0, 0};
+  for (int i = 0; i < frameCount; ++i) {
+    CookedFrame bounds = opaqueBounds(rgba.get(), i * frameWidth, frameWidth);
+    frames.push_back(bounds);
+
+    if (bounds.w <= 0)
+      continue;
+
+    if (hitbox.w <= 0) {
+      hitbox = bounds;
+    } else {
+      float right = std::max(hitbox.x + hitbox.w, bounds.x + bounds.w);
+      float bottom = std::max(hitbox.y + hitbox.h, bounds.y + bounds.h);
+      hitbox.x = std::min(hitbox.x, bounds.x);
+      hitbox.y = std::min(hitbox.y, bounds.y);
+      hitbox.w = right - hitbox.x;
+      hitbox.h = bottom - hitbox.y;
+    }
+  }
+
+  // Tightly packed rows, so the runtime can decompress straight into a surface
+  std::vector<char> pixels(static_cast<size_t>(width) * height * 4);
+  for (int y = 0; y < height; ++y) {
+    std::memcpy(pixels.data() + static_cast<size_t>(y) * width * 4,
+                static_cast<const uint8_t *>(cooked->pixels) + y * cooked->pitch, static_cast<size_t>(width) * 4);
+  }
+
+  std::vector<char> compressed(LZ4_compressBound(static_cast<int>(pixels.size())));
+  int compressedSize = LZ4_compress_HC(pixels.data(), compressed.data(), static_cast<int>(pixels.size()),
+                                       static_cast<int>(compressed.size()), LZ4HC_CLEVEL_MAX);
+  if (compressedSize <= 0) {
+    std::cerr << "Failed to compress " << inputPath << '\n';
+    return 1;
+  }
+
+  CookedTextureHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.pixelFormat = static_cast<uint32_t>(pixelFormat);
+  header.width = static_cast<uint32_t>(width);
+  header.height = static_cast<uint32_t>(height);
+  header.frameCount = static_cast<uint32_t>(frameCount);
+  header.compressedSize = static_cast<uint32_t>(compressedSize);
+  header.hitboxX = hitbox.x;
+  header.hitboxY = hitbox.y;
+  header.hitboxW = hitbox.w;
+  header.hitboxH = hitbox.h;
+
+  std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+  output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  output.write(reinterpret_cast<const char *>(frames.data()), static_cast<std::streamsize>(sizeof(CookedFrame) * frames.size()));
+  output.write(compressed.data(), compressedSize);
+
+  if (!output) {
+    std::cerr << "Failed to write " << outputPath << '\n';
+    return 1;
+  }
+
+  std::cout << "Cooked " << inputPath << ": " << width << "x" << height << ", " << frameCount << " frames, "
+            << pixels.size() << " -> " << compressedSize << " bytes" << '\n';
+  return 0;
+}
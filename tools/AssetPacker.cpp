@@ -0,0 +1,126 @@
+// Packs every file under one or more resource directories into a single archive read by AssetArchive.
+//
+//   AssetPacker <output archive> <resource directory>...
+//
+// Entries are stored relative to the parent of their resource directory, so both
+// "resources/" and a cooked "<build>/cooked/resources/" map to the paths the game already uses,
+// e.g. "resources/fonts/vgasyse.ttf", and lookups work unchanged with or without the archive.
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "utils/AssetArchiveFormat.h"
+
+namespace fs = std::filesystem;
+
+struct PackedFile {
+  std::string path;
+  std::vector<char> data;
+};
+
+bool readFile(const fs::path &path, std::vector<char> &data) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    return false;
+
+  data.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  return static_cast<bool>(file.read(data.data(), static_cast<std::streamsize>(data.size())));
+}
+
+int main(int argc, char *argv[]) {
+  using namespace AssetArchiveFormat;
+
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <output archive> <resource directory>..." << '\n';
+    return 1;
+  }
+
+  const fs::path outputPath = argv[1];
+
+  std::vector<PackedFile> files;
+  for (int arg = 2; arg < argc; ++arg) {
+    fs::path resourceDir = fs::absolute(argv[arg]).lexically_normal();
+    if (!resourceDir.has_filename()) {
+      resourceDir = resourceDir.parent_path();
+    }
+    const fs::path pathBase = resourceDir.parent_path();
+
+    if (!fs::is_directory(resourceDir)) {
+      std::cerr << "Not a directory: " << resourceDir << '\n';
+      return 1;
+    }
+
+    for (const auto &entry : fs::recursive_directory_iterator(resourceDir)) {
+      if (!entry.is_regular_file())
+        continue;
+
+      PackedFile file;
+      file.path = fs::relative(entry.path(), pathBase).generic_string();
+      if (!readFile(entry.path(), file.data)) {
+        std::cerr << "Failed to read " << entry.path() << '\n';
+        return 1;
+      }
+      files.push_back(std::move(file));
+    }
+  }
+
+  // Deterministic output regardless of directory iteration order
+  std::sort(files.begin(), files.end(), [](const PackedFile &a, const PackedFile &b) { return a.path < b.path; });
+
+  ArchiveHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.entryCount = static_cast<uint32_t>(files.size());
+
+  std::vector<ArchiveEntry> entries(files.size());
+  std::string pathTable;
+
+  uint64_t pathTableOffset = sizeof(ArchiveHeader) + sizeof(ArchiveEntry) * files.size();
+  for (size_t i = 0; i < files.size(); ++i) {
+    entries[i].pathOffset = static_cast<uint32_t>(pathTableOffset + pathTable.size());
+    entries[i].pathLength = static_cast<uint32_t>(files[i].path.size());
+    pathTable += files[i].path;
+  }
+
+  uint64_t dataOffset = alignUp(pathTableOffset + pathTable.size(), DATA_ALIGNMENT);
+  for (size_t i = 0; i < files.size(); ++i) {
+    entries[i].dataOffset = dataOffset;
+    entries[i].dataSize = files[i].data.size();
+    dataOffset = alignUp(dataOffset + files[i].data.size(), DATA_ALIGNMENT);
+  }
+
+  std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+  if (!output) {
+    std::cerr << "Failed to open " << outputPath << " for writing" << '\n';
+    return 1;
+  }
+
+  auto padTo = [&output](uint64_t offset) {
+    static const char zeros[DATA_ALIGNMENT] = {};
+    uint64_t position = static_cast<uint64_t>(output.tellp());
+    output.write(zeros, static_cast<std::streamsize>(offset - position));
+  };
+
+  output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  output.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(sizeof(ArchiveEntry) * entries.size()));
+  output.write(pathTable.data(), static_cast<std::streamsize>(pathTable.size()));
+
+  for (size_t i = 0; i < files.size(); ++i) {
+    padTo(entries[i].dataOffset);
+    output.write(files[i].data.data(), static_cast<std::streamsize>(files[i].data.size()));
+  }
+
+  if (!output) {
+    std::cerr << "Failed to write " << outputPath << '\n';
+    return 1;
+  }
+
+  std::cout << "Packed " << files.size() << " assets into " << outputPath.string() << " (" << output.tellp() << " bytes)" << '\n';
+  return 0;
+}
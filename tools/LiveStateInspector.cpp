@@ -0,0 +1,204 @@
+// Reads the live state the game publishes with --live-state and prints it while the game runs.
+//
+//   LiveStateInspector [--name=<segment>] [--once | --csv]
+//
+// By default the terminal is redrawn ten times a second. --csv prints one row per published tick,
+// for plotting frame times or positions with any spreadsheet or plotting tool.
+// The game is never blocked, a snapshot torn by a concurrent write is simply read again.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "utils/LiveStateFormat.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using namespace LiveStateFormat;
+
+// Mirrors GameState, PlayerAnimState, SpecialMove and CollisionType, the tool does not link the game
+const char *const GAME_STATE_NAMES[] = {"LOADING", "MAINMENU", "GAMELOOP", "STRESS"};
+const char *const ANIM_STATE_NAMES[] = {"IDLE", "RUN", "TAKING_PUNCH"};
+const char *const SPECIAL_NAMES[] = {"NONE", "LUNGE_PUNCH", "RETREAT_PUNCH"};
+const char *const COLLISION_NAMES[] = {"BOUNDARY", "PLAYER_VS_PLAYER", "ATTACK_HIT"};
+
+template <size_t N>
+const char *nameOf(const char *const (&names)[N], uint32_t value) {
+  return value < N ? names[value] : "?";
+}
+
+const Segment *mapSegment(const std::string &segmentName) {
+#ifdef _WIN32
+  HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, segmentName.c_str());
+  if (!mapping)
+    return nullptr;
+
+  // The mapping stays alive as long as the view does
+  void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(Segment));
+  CloseHandle(mapping);
+  return static_cast<const Segment *>(view);
+#else
+  int fd = shm_open(("/" + segmentName).c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return nullptr;
+
+  void *view = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  return view == MAP_FAILED ? nullptr : static_cast<const Segment *>(view);
+#endif
+}
+
+void unmapSegment(const Segment *segment) {
+#ifdef _WIN32
+  UnmapViewOfFile(segment);
+#else
+  munmap(const_cast<Segment *>(segment), sizeof(Segment));
+#endif
+}
+
+// Spins over torn reads, a write is a single memcpy so this settles almost immediately
+void readSnapshot(const Segment &segment, Snapshot &snapshot) {
+  while (!tryReadSnapshot(segment, snapshot)) {
+    std::this_thread::yield();
+  }
+}
+
+void printSnapshot(const Snapshot &snapshot) {
+  std::printf("tick %llu  state %s  frame %.2f ms (update %.2f, render %.2f)\n",
+              static_cast<unsigned long long>(snapshot.tick), nameOf(GAME_STATE_NAMES, snapshot.gameState),
+              snapshot.frameMs, snapshot.updateMs, snapshot.renderMs);
+
+  // One # per millisecond, a 60 fps frame is about 17 wide
+  std::string bar(static_cast<size_t>(std::min(snapshot.frameMs, 100.0f)), '#');
+  std::printf("  %s\n", bar.c_str());
+
+  for (uint32_t i = 0; i < snapshot.playerCount && i < MAX_PLAYERS; ++i) {
+    const PlayerState &player = snapshot.players[i];
+    std::printf("player %u  pos (%.1f, %.1f)  vel (%.1f, %.1f)  dir %+.0f  %s frame %u  %s  special %s\n", i + 1,
+                player.positionX, player.positionY, player.velocityX, player.velocityY, player.direction,
+                nameOf(ANIM_STATE_NAMES, player.animState), player.animFrame, player.grounded ? "grounded" : "airborne",
+                nameOf(SPECIAL_NAMES, player.lastSpecial));
+  }
+
+  std::printf("collisions %u\n", snapshot.collisionCount);
+  for (uint32_t i = 0; i < snapshot.collisionCount && i < MAX_COLLISIONS; ++i) {
+    const CollisionState &collision = snapshot.collisions[i];
+    std::printf("  %-16s at (%.1f, %.1f)  normal (%.2f, %.2f)  depth %.2f\n", nameOf(COLLISION_NAMES, collision.type),
+                collision.contactX, collision.contactY, collision.normalX, collision.normalY, collision.penetration);
+  }
+}
+
+void printCsvHeader() {
+  std::printf("tick,time_ns,frame_ms,update_ms,render_ms,collisions");
+  for (uint32_t i = 1; i <= MAX_PLAYERS; ++i) {
+    std::printf(",p%u_x,p%u_y,p%u_vx,p%u_vy,p%u_anim", i, i, i, i, i);
+  }
+  std::printf("\n");
+}
+
+void printCsvRow(const Snapshot &snapshot) {
+  std::printf("%llu,%llu,%.3f,%.3f,%.3f,%u", static_cast<unsigned long long>(snapshot.tick),
+              static_cast<unsigned long long>(snapshot.timeNs), snapshot.frameMs, snapshot.updateMs,
+              snapshot.renderMs, snapshot.collisionCount);
+  for (uint32_t i = 0; i < MAX_PLAYERS; ++i) {
+    const PlayerState &player = snapshot.players[i];
+    if (i < snapshot.playerCount) {
+      std::printf(",%.2f,%.2f,%.2f,%.2f,%u", player.positionX, player.positionY, player.velocityX, player.velocityY,
+                  player.animState);
+    } else {
+      std::printf(",,,,,");
+    }
+  }
+  std::printf("\n");
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  std::string segmentName = DEFAULT_SEGMENT_NAME;
+  bool once = false;
+  bool csv = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg.starts_with("--name=")) {
+      segmentName = std::string(arg.substr(std::string_view("--name=").size()));
+    } else if (arg == "--once") {
+      once = true;
+    } else if (arg == "--csv") {
+      csv = true;
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--name=<segment>] [--once | --csv]" << '\n';
+      return 1;
+    }
+  }
+
+  // The segment may not exist yet, or exist before the game has written its header
+  const Segment *segment = nullptr;
+  bool waitingReported = false;
+  while (true) {
+    segment = mapSegment(segmentName);
+    if (segment && isCompatible(segment->header))
+      break;
+
+    if (segment) {
+      uint32_t version = segment->header.version;
+      unmapSegment(segment);
+      if (version != 0 && version != VERSION) {
+        std::cerr << "Segment version " << version << " is not supported, expected " << VERSION << '\n';
+        return 1;
+      }
+    }
+
+    if (!waitingReported) {
+      std::cerr << "Waiting for the game to publish " << segmentName << " (run it with --live-state)" << '\n';
+      waitingReported = true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  }
+
+  Snapshot snapshot{};
+
+  if (once) {
+    readSnapshot(*segment, snapshot);
+    printSnapshot(snapshot);
+    return 0;
+  }
+
+  if (csv) {
+    printCsvHeader();
+
+    // Polls faster than the game ticks so every tick is seen
+    uint64_t lastTick = UINT64_MAX;
+    while (true) {
+      readSnapshot(*segment, snapshot);
+      if (snapshot.tick != lastTick) {
+        printCsvRow(snapshot);
+        std::fflush(stdout);
+        lastTick = snapshot.tick;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  while (true) {
+    readSnapshot(*segment, snapshot);
+    std::printf("\033[H\033[2J");
+    printSnapshot(snapshot);
+    std::fflush(stdout);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+}